@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2020 - 2024                                             *
+ *   Copyright (C) 2020 - 2026                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -20,22 +20,67 @@
 
 #include "agg_file.h"
 
+#include <cassert>
 #include <cctype>
 #include <cstdint>
 #include <iterator>
 #include <string>
 
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define AGG_FILE_POSIX_MMAP
+#endif
+
 namespace fheroes2
 {
+    AGGFile::~AGGFile()
+    {
+        _unmap();
+    }
+
     bool AGGFile::open( const std::string & fileName )
     {
+        _files.clear();
+        _unmap();
+
+        const size_t fileRecordSize = sizeof( uint32_t ) * 3;
+
+        if ( _map( fileName ) ) {
+            ROStreamBuf header( _mappedData, _mappedSize );
+
+            const size_t count = header.getLE16();
+            if ( count * ( fileRecordSize + _maxFilenameSize ) >= _mappedSize ) {
+                _unmap();
+                return false;
+            }
+
+            const size_t nameEntriesSize = _maxFilenameSize * count;
+
+            ROStreamBuf fileEntries( _mappedData + sizeof( uint16_t ), count * fileRecordSize );
+            ROStreamBuf nameEntries( _mappedData + _mappedSize - nameEntriesSize, nameEntriesSize );
+
+            if ( !_readFileEntries( fileEntries, nameEntries, count ) ) {
+                _unmap();
+                return false;
+            }
+
+            return true;
+        }
+
+        // Memory mapping is not supported or has failed, so the AGG file is going to be read as a regular file.
         if ( !_stream.open( fileName, "rb" ) ) {
             return false;
         }
 
         const size_t size = _stream.size();
         const size_t count = _stream.getLE16();
-        const size_t fileRecordSize = sizeof( uint32_t ) * 3;
 
         if ( count * ( fileRecordSize + _maxFilenameSize ) >= size ) {
             return false;
@@ -46,6 +91,42 @@ namespace fheroes2
         _stream.seek( size - nameEntriesSize );
         ROStreamBuf nameEntries = _stream.getStreamBuf( nameEntriesSize );
 
+        if ( !_readFileEntries( fileEntries, nameEntries, count ) ) {
+            return false;
+        }
+
+        return !_stream.fail();
+    }
+
+    AGGFileData AGGFile::read( const std::string & fileName ) const
+    {
+        auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return {};
+        }
+
+        const auto [fileSize, fileOffset] = it->second;
+        if ( fileSize == 0 ) {
+            return {};
+        }
+
+        if ( _mappedData != nullptr ) {
+            if ( static_cast<size_t>( fileOffset ) + fileSize > _mappedSize ) {
+                // This is a corrupted AGG file.
+                return {};
+            }
+
+            return { _mappedData + fileOffset, fileSize };
+        }
+
+        const std::scoped_lock<std::mutex> lock( _streamMutex );
+
+        _stream.seek( fileOffset );
+        return AGGFileData( _stream.getRaw( fileSize ) );
+    }
+
+    bool AGGFile::_readFileEntries( ROStreamBuf & fileEntries, ROStreamBuf & nameEntries, const size_t count )
+    {
         for ( size_t i = 0; i < count; ++i ) {
             std::string name = nameEntries.getString( _maxFilenameSize );
 
@@ -66,23 +147,92 @@ namespace fheroes2
             return false;
         }
 
-        return !_stream.fail();
+        return true;
     }
 
-    std::vector<uint8_t> AGGFile::read( const std::string & fileName )
+    bool AGGFile::_map( const std::string & fileName )
     {
-        auto it = _files.find( fileName );
-        if ( it == _files.end() ) {
-            return {};
+        assert( _mappedData == nullptr );
+
+#if defined( _WIN32 )
+        const HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            return false;
         }
 
-        const auto [fileSize, fileOffset] = it->second;
-        if ( fileSize > 0 ) {
-            _stream.seek( fileOffset );
-            return _stream.getRaw( fileSize );
+        LARGE_INTEGER fileSize;
+        if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 ) {
+            CloseHandle( file );
+            return false;
+        }
+
+        const HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        // The mapping keeps the file open by itself.
+        CloseHandle( file );
+
+        if ( mapping == nullptr ) {
+            return false;
+        }
+
+        const void * data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        // The view keeps the mapping alive by itself.
+        CloseHandle( mapping );
+
+        if ( data == nullptr ) {
+            return false;
         }
 
-        return {};
+        _mappedData = static_cast<const uint8_t *>( data );
+        _mappedSize = static_cast<size_t>( fileSize.QuadPart );
+
+        return true;
+#elif defined( AGG_FILE_POSIX_MMAP )
+        const int file = ::open( fileName.c_str(), O_RDONLY );
+        if ( file < 0 ) {
+            return false;
+        }
+
+        struct stat fileStat{};
+        if ( fstat( file, &fileStat ) != 0 || fileStat.st_size <= 0 ) {
+            close( file );
+            return false;
+        }
+
+        const size_t fileSize = static_cast<size_t>( fileStat.st_size );
+
+        void * data = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0 );
+        // The mapping keeps the file open by itself.
+        close( file );
+
+        if ( data == MAP_FAILED ) {
+            return false;
+        }
+
+        _mappedData = static_cast<const uint8_t *>( data );
+        _mappedSize = fileSize;
+
+        return true;
+#else
+        (void)fileName;
+
+        return false;
+#endif
+    }
+
+    void AGGFile::_unmap()
+    {
+        if ( _mappedData == nullptr ) {
+            return;
+        }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( _mappedData );
+#elif defined( AGG_FILE_POSIX_MMAP )
+        munmap( const_cast<uint8_t *>( _mappedData ), _mappedSize );
+#endif
+
+        _mappedData = nullptr;
+        _mappedSize = 0;
     }
 
     uint32_t calculateAggFilenameHash( const std::string_view str )
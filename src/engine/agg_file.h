@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -33,21 +34,113 @@
 
 namespace fheroes2
 {
+    // Data of a file stored in an AGG file. If the AGG file is memory-mapped then this is a non-owning view of the mapped memory
+    // which stays valid as long as the AGG file is open. Otherwise it owns a copy of the data.
+    class AGGFileData
+    {
+    public:
+        AGGFileData() = default;
+
+        AGGFileData( const uint8_t * data, const size_t size )
+            : _data( data )
+            , _size( size )
+        {
+            // Do nothing.
+        }
+
+        explicit AGGFileData( std::vector<uint8_t> && buf )
+            : _buf( std::move( buf ) )
+            , _data( _buf.data() )
+            , _size( _buf.size() )
+        {
+            // Do nothing.
+        }
+
+        AGGFileData( const AGGFileData & ) = delete;
+        // The data of a moved vector stays at the same address so the default move operations are safe to use.
+        AGGFileData( AGGFileData && ) = default;
+
+        ~AGGFileData() = default;
+
+        AGGFileData & operator=( const AGGFileData & ) = delete;
+        AGGFileData & operator=( AGGFileData && ) = default;
+
+        const uint8_t * data() const
+        {
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        const uint8_t * begin() const
+        {
+            return _data;
+        }
+
+        const uint8_t * end() const
+        {
+            return _data + _size;
+        }
+
+        // Returns a copy of the data. Use it only for small files which have to be passed somewhere as a vector.
+        std::vector<uint8_t> toVector() const
+        {
+            return { begin(), end() };
+        }
+
+    private:
+        // This buffer is not used in the non-owning ("view") mode.
+        std::vector<uint8_t> _buf;
+
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+    };
+
     class AGGFile
     {
     public:
+        AGGFile() = default;
+        AGGFile( const AGGFile & ) = delete;
+
+        ~AGGFile();
+
+        AGGFile & operator=( const AGGFile & ) = delete;
+
         bool isGood() const
         {
-            return !_stream.fail() && !_files.empty();
+            return !_files.empty() && ( _mappedData != nullptr || !_stream.fail() );
         }
 
         bool open( const std::string & fileName );
-        std::vector<uint8_t> read( const std::string & fileName );
+
+        // This method can be called from several threads at the same time. No data is copied if the AGG file is memory-mapped,
+        // which is the case on all platforms supporting memory mapping.
+        AGGFileData read( const std::string & fileName ) const;
 
     private:
         static const size_t _maxFilenameSize = 15; // 8.3 ASCIIZ file name + 2-bytes padding
 
-        StreamFile _stream;
+        bool _readFileEntries( ROStreamBuf & fileEntries, ROStreamBuf & nameEntries, const size_t count );
+
+        bool _map( const std::string & fileName );
+        void _unmap();
+
+        // The content of the whole AGG file mapped into memory.
+        const uint8_t * _mappedData{ nullptr };
+        size_t _mappedSize{ 0 };
+
+        // The stream is used only if the AGG file cannot be memory-mapped. Its read position is shared so it must be guarded by the mutex.
+        mutable StreamFile _stream;
+        mutable std::mutex _streamMutex;
+
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _files;
     };
 
@@ -27,6 +27,16 @@
 #include <cstdlib>
 #include <cstring>
 
+// SSE2 is always available on x86-64, NEON is always available on AArch64 and is optional on 32-bit ARM,
+// so there is no need to check for their support at runtime
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define FHEROES2_IMAGE_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#define FHEROES2_IMAGE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #include "image_palette.h"
 
 namespace
@@ -453,12 +463,273 @@ namespace
             }
         }
     }
+
+    void blitPixelToSingleLayer( const uint8_t imageIn, const uint8_t transformIn, uint8_t & imageOut )
+    {
+        if ( transformIn > 0 ) { // apply a transformation
+            if ( transformIn != 1 ) { // skip pixel
+                imageOut = *( transformTable + transformIn * 256 + imageOut );
+            }
+        }
+        else { // copy a pixel
+            imageOut = imageIn;
+        }
+    }
+
+    void blitPixelToDoubleLayer( const uint8_t imageIn, const uint8_t transformIn, uint8_t & imageOut, uint8_t & transformOut )
+    {
+        if ( transformIn == 1 ) { // skip pixel
+            return;
+        }
+
+        if ( transformIn > 0 && transformOut == 0 ) { // apply a transformation
+            imageOut = *( transformTable + transformIn * 256 + imageOut );
+        }
+        else { // copy a pixel
+            transformOut = transformIn;
+            imageOut = imageIn;
+        }
+    }
+
+#if defined( FHEROES2_IMAGE_SIMD_SSE2 ) || defined( FHEROES2_IMAGE_SIMD_NEON )
+    // Most of the pixels of sprites are either copied as is or skipped, so such pixels are processed in blocks. Blocks containing
+    // pixels to be transformed (shadows) are rare and are processed pixel by pixel, because table lookups cannot be vectorized.
+    const int32_t pixelBlockSize = 16;
+
+#if defined( FHEROES2_IMAGE_SIMD_SSE2 )
+    using PixelBlock = __m128i;
+
+    PixelBlock loadBlock( const uint8_t * data )
+    {
+        return _mm_loadu_si128( reinterpret_cast<const __m128i *>( data ) );
+    }
+
+    void storeBlock( uint8_t * data, const PixelBlock block )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( data ), block );
+    }
+
+    PixelBlock isEqual( const PixelBlock block, const uint8_t value )
+    {
+        return _mm_cmpeq_epi8( block, _mm_set1_epi8( static_cast<char>( value ) ) );
+    }
+
+    PixelBlock isGreaterThanOne( const PixelBlock block )
+    {
+        // There is no unsigned comparison in SSE2: max( x, 2 ) == x if and only if x >= 2
+        return _mm_cmpeq_epi8( _mm_max_epu8( block, _mm_set1_epi8( 2 ) ), block );
+    }
+
+    PixelBlock andMask( const PixelBlock first, const PixelBlock second )
+    {
+        return _mm_and_si128( first, second );
+    }
+
+    // Takes the values from 'first' where the mask is set, and from 'second' elsewhere
+    PixelBlock selectByMask( const PixelBlock mask, const PixelBlock first, const PixelBlock second )
+    {
+        return _mm_or_si128( _mm_and_si128( mask, first ), _mm_andnot_si128( mask, second ) );
+    }
+
+    bool isAnySet( const PixelBlock mask )
+    {
+        return _mm_movemask_epi8( mask ) != 0;
+    }
+
+    bool areAllSet( const PixelBlock mask )
+    {
+        return _mm_movemask_epi8( mask ) == 0xFFFF;
+    }
+#else
+    using PixelBlock = uint8x16_t;
+
+    PixelBlock loadBlock( const uint8_t * data )
+    {
+        return vld1q_u8( data );
+    }
+
+    void storeBlock( uint8_t * data, const PixelBlock block )
+    {
+        vst1q_u8( data, block );
+    }
+
+    PixelBlock isEqual( const PixelBlock block, const uint8_t value )
+    {
+        return vceqq_u8( block, vdupq_n_u8( value ) );
+    }
+
+    PixelBlock isGreaterThanOne( const PixelBlock block )
+    {
+        return vcgtq_u8( block, vdupq_n_u8( 1 ) );
+    }
+
+    PixelBlock andMask( const PixelBlock first, const PixelBlock second )
+    {
+        return vandq_u8( first, second );
+    }
+
+    // Takes the values from 'first' where the mask is set, and from 'second' elsewhere
+    PixelBlock selectByMask( const PixelBlock mask, const PixelBlock first, const PixelBlock second )
+    {
+        return vbslq_u8( mask, first, second );
+    }
+
+    bool isAnySet( const PixelBlock mask )
+    {
+        const uint64x2_t mask64 = vreinterpretq_u64_u8( mask );
+        return ( vgetq_lane_u64( mask64, 0 ) | vgetq_lane_u64( mask64, 1 ) ) != 0;
+    }
+
+    bool areAllSet( const PixelBlock mask )
+    {
+        const uint64x2_t mask64 = vreinterpretq_u64_u8( mask );
+        return ( vgetq_lane_u64( mask64, 0 ) & vgetq_lane_u64( mask64, 1 ) ) == UINT64_MAX;
+    }
+#endif
+
+    bool areRowsOverlapping( const uint8_t * first, const uint8_t * second, const int32_t width )
+    {
+        return first < second + width && second < first + width;
+    }
+#endif
+
+    void blitRowToSingleLayer( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+#if defined( FHEROES2_IMAGE_SIMD_SSE2 ) || defined( FHEROES2_IMAGE_SIMD_NEON )
+        // Block processing reads several output pixels before writing any of them, which is not the same as pixel by pixel processing
+        // if the input and output overlap
+        if ( !areRowsOverlapping( imageIn, imageOut, width ) ) {
+            for ( ; x + pixelBlockSize <= width; x += pixelBlockSize ) {
+                const PixelBlock transformBlock = loadBlock( transformIn + x );
+
+                if ( isAnySet( isGreaterThanOne( transformBlock ) ) ) {
+                    for ( int32_t i = x; i < x + pixelBlockSize; ++i ) {
+                        blitPixelToSingleLayer( imageIn[i], transformIn[i], imageOut[i] );
+                    }
+                    continue;
+                }
+
+                const PixelBlock copyMask = isEqual( transformBlock, 0 );
+                if ( areAllSet( copyMask ) ) {
+                    storeBlock( imageOut + x, loadBlock( imageIn + x ) );
+                }
+                else if ( isAnySet( copyMask ) ) {
+                    storeBlock( imageOut + x, selectByMask( copyMask, loadBlock( imageIn + x ), loadBlock( imageOut + x ) ) );
+                }
+            }
+        }
+#endif
+
+        for ( ; x < width; ++x ) {
+            blitPixelToSingleLayer( imageIn[x], transformIn[x], imageOut[x] );
+        }
+    }
+
+    void blitRowToDoubleLayer( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+#if defined( FHEROES2_IMAGE_SIMD_SSE2 ) || defined( FHEROES2_IMAGE_SIMD_NEON )
+        if ( !areRowsOverlapping( imageIn, imageOut, width ) && !areRowsOverlapping( transformIn, transformOut, width ) ) {
+            for ( ; x + pixelBlockSize <= width; x += pixelBlockSize ) {
+                const PixelBlock transformInBlock = loadBlock( transformIn + x );
+                const PixelBlock transformOutBlock = loadBlock( transformOut + x );
+
+                if ( isAnySet( andMask( isGreaterThanOne( transformInBlock ), isEqual( transformOutBlock, 0 ) ) ) ) {
+                    for ( int32_t i = x; i < x + pixelBlockSize; ++i ) {
+                        blitPixelToDoubleLayer( imageIn[i], transformIn[i], imageOut[i], transformOut[i] );
+                    }
+                    continue;
+                }
+
+                // There are no pixels to transform in this block, so all pixels that are not skipped are copied
+                const PixelBlock skipMask = isEqual( transformInBlock, 1 );
+                if ( areAllSet( skipMask ) ) {
+                    continue;
+                }
+
+                storeBlock( imageOut + x, selectByMask( skipMask, loadBlock( imageOut + x ), loadBlock( imageIn + x ) ) );
+                storeBlock( transformOut + x, selectByMask( skipMask, transformOutBlock, transformInBlock ) );
+            }
+        }
+#endif
+
+        for ( ; x < width; ++x ) {
+            blitPixelToDoubleLayer( imageIn[x], transformIn[x], imageOut[x], transformOut[x] );
+        }
+    }
+
+    // Draws the area of the input image using its spans. The result is identical to the drawing of every pixel by the functions above.
+    void blitSpans( const fheroes2::Image & in, const fheroes2::ImageSpans & spans, const int32_t inX, const int32_t inY, uint8_t * imageOut, uint8_t * transformOut,
+                    const int32_t widthOut, const int32_t width, const int32_t height, const bool flip )
+    {
+        const int32_t widthIn = in.width();
+
+        // The range of the columns of the input image to be drawn. When the image is flipped, its columns are counted from the right side.
+        const int32_t inXBegin = flip ? widthIn - inX - width : inX;
+        const int32_t inXEnd = inXBegin + width;
+
+        const uint8_t * imageInY = in.image() + static_cast<ptrdiff_t>( inY ) * widthIn;
+        const uint8_t * transformInY = in.transform() + static_cast<ptrdiff_t>( inY ) * widthIn;
+
+        for ( int32_t y = 0; y < height; ++y, imageInY += widthIn, transformInY += widthIn, imageOut += widthOut ) {
+            const fheroes2::ImageSpans::Span * span = spans.spans.data() + spans.rowBegin[inY + y];
+            const fheroes2::ImageSpans::Span * rowSpansEnd = spans.spans.data() + spans.rowBegin[inY + y + 1];
+
+            for ( ; span != rowSpansEnd; ++span ) {
+                const int32_t spanBegin = std::max( span->offset, inXBegin );
+                const int32_t spanEnd = std::min( span->offset + span->length, inXEnd );
+                if ( spanBegin >= spanEnd ) {
+                    continue;
+                }
+
+                const int32_t length = spanEnd - spanBegin;
+
+                // Offset of the first pixel of the span in the output row. When flipped, the span is drawn from right to left.
+                const int32_t outOffset = flip ? inXEnd - spanEnd : spanBegin - inXBegin;
+
+                if ( span->transformId == 0 ) {
+                    if ( flip ) {
+                        std::reverse_copy( imageInY + spanBegin, imageInY + spanEnd, imageOut + outOffset );
+                    }
+                    else {
+                        memcpy( imageOut + outOffset, imageInY + spanBegin, static_cast<size_t>( length ) );
+                    }
+
+                    if ( transformOut != nullptr ) {
+                        memset( transformOut + outOffset, static_cast<uint8_t>( 0 ), static_cast<size_t>( length ) );
+                    }
+
+                    continue;
+                }
+
+                for ( int32_t i = 0; i < length; ++i ) {
+                    const int32_t inPos = flip ? spanEnd - 1 - i : spanBegin + i;
+                    const int32_t outPos = outOffset + i;
+
+                    if ( transformOut == nullptr ) {
+                        blitPixelToSingleLayer( imageInY[inPos], transformInY[inPos], imageOut[outPos] );
+                    }
+                    else {
+                        blitPixelToDoubleLayer( imageInY[inPos], transformInY[inPos], imageOut[outPos], transformOut[outPos] );
+                    }
+                }
+            }
+
+            if ( transformOut != nullptr ) {
+                transformOut += widthOut;
+            }
+        }
+    }
 }
 
 namespace fheroes2
 {
     Image::Image( Image && image ) noexcept
         : _data( std::move( image._data ) )
+        , _spans( std::move( image._spans ) )
     {
         std::swap( _width, image._width );
         std::swap( _height, image._height );
@@ -486,12 +757,16 @@ namespace fheroes2
         std::swap( _height, image._height );
         std::swap( _data, image._data );
         std::swap( _singleLayer, image._singleLayer );
+        std::swap( _spans, image._spans );
 
         return *this;
     }
 
     uint8_t * Image::image()
     {
+        // The image can be modified through the returned pointer
+        _spans.reset();
+
         return _data.get();
     }
 
@@ -503,6 +778,7 @@ namespace fheroes2
     void Image::clear()
     {
         _data.reset();
+        _spans.reset();
 
         _width = 0;
         _height = 0;
@@ -543,6 +819,46 @@ namespace fheroes2
 
         _width = width_;
         _height = height_;
+
+        _spans.reset();
+    }
+
+    void Image::buildSpans()
+    {
+        // Single-layer images have no transparent pixels, so there is nothing to skip
+        if ( empty() || _singleLayer ) {
+            _spans.reset();
+            return;
+        }
+
+        auto spans = std::make_shared<ImageSpans>();
+        spans->rowBegin.reserve( static_cast<size_t>( _height ) + 1 );
+
+        const uint8_t * transformY = _data.get() + static_cast<size_t>( _width ) * _height;
+
+        for ( int32_t y = 0; y < _height; ++y, transformY += _width ) {
+            spans->rowBegin.push_back( static_cast<uint32_t>( spans->spans.size() ) );
+
+            for ( int32_t x = 0; x < _width; ) {
+                const uint8_t transformId = transformY[x];
+
+                int32_t runEnd = x + 1;
+                while ( runEnd < _width && transformY[runEnd] == transformId ) {
+                    ++runEnd;
+                }
+
+                if ( transformId != 1 ) {
+                    spans->spans.push_back( { x, runEnd - x, transformId } );
+                }
+
+                x = runEnd;
+            }
+        }
+
+        spans->rowBegin.push_back( static_cast<uint32_t>( spans->spans.size() ) );
+        spans->spans.shrink_to_fit();
+
+        _spans = std::move( spans );
     }
 
     void Image::reset()
@@ -583,6 +899,8 @@ namespace fheroes2
         }
 
         memcpy( _data.get(), image._data.get(), _singleLayer ? imageSize : imageSize * 2 );
+
+        _spans = image._spans;
     }
 
     Sprite::Sprite( Sprite && sprite ) noexcept
@@ -1217,6 +1535,17 @@ namespace fheroes2
         const int32_t widthIn = in.width();
         const int32_t widthOut = out.width();
 
+        const int32_t offsetOut = outY * widthOut + outX;
+        uint8_t * imageOut = out.image() + offsetOut;
+        uint8_t * transformOut = out.singleLayer() ? nullptr : out.transform() + offsetOut;
+
+        // Non-const access to the output image drops its spans, so the spans of the input image are obtained
+        // only afterwards in case both images are the same.
+        if ( const ImageSpans * spans = in.spans(); spans != nullptr ) {
+            blitSpans( in, *spans, inX, inY, imageOut, transformOut, widthOut, width, height, flip );
+            return;
+        }
+
         if ( flip ) {
             const int32_t offsetInY = inY * widthIn + widthIn - 1 - inX;
             const uint8_t * imageInY = in.image() + offsetInY;
@@ -1284,46 +1613,14 @@ namespace fheroes2
             if ( out.singleLayer() ) {
                 assert( !in.singleLayer() );
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    blitRowToSingleLayer( imageInY, transformInY, imageOutY, width );
                 }
             }
             else {
                 uint8_t * transformOutY = out.transform() + offsetOutY;
 
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    blitRowToDoubleLayer( imageInY, transformInY, imageOutY, transformOutY, width );
                 }
             }
         }
@@ -30,6 +30,23 @@
 
 namespace fheroes2
 {
+    // Runs of adjacent pixels of an image with the same transform value, row by row. Pixels to be skipped (transform value 1) are not included,
+    // so drawing functions can process the opaque and the shadow pixels of mostly transparent images without looking at the transparent ones.
+    struct ImageSpans
+    {
+        struct Span
+        {
+            int32_t offset{ 0 };
+            int32_t length{ 0 };
+            uint8_t transformId{ 0 };
+        };
+
+        std::vector<Span> spans;
+
+        // Spans of row Y are stored in [ rowBegin[Y], rowBegin[Y + 1] )
+        std::vector<uint32_t> rowBegin;
+    };
+
     // Image always contains an image layer and if image is not a single-layer then also a transform layer.
     // - image layer contains visible pixels which are copy to a destination image
     // - transform layer is used to apply some transformation to an image on which we draw the current one. For example, shadowing
@@ -77,6 +94,9 @@ namespace fheroes2
             // Why do you want to get transform layer from the single-layer image?
             assert( !_singleLayer );
 
+            // The image can be modified through the returned pointer
+            _spans.reset();
+
             return _singleLayer ? nullptr : _data.get() + width() * height();
         }
 
@@ -112,6 +132,17 @@ namespace fheroes2
         void _disableTransformLayer()
         {
             _singleLayer = true;
+            _spans.reset();
+        }
+
+        // Builds pixel spans of this image to speed up its drawing. Use only for images which are drawn many times without being modified,
+        // because spans are dropped on any non-const access to the image layers.
+        void buildSpans();
+
+        // Returns nullptr if there are no spans for this image
+        const ImageSpans * spans() const
+        {
+            return _spans.get();
         }
 
     private:
@@ -123,6 +154,9 @@ namespace fheroes2
 
         // Only for images which are not used for any other operations except displaying on screen.
         bool _singleLayer{ false };
+
+        // Spans are never modified after being built, so they are shared between copies of the image
+        std::shared_ptr<const ImageSpans> _spans;
     };
 
     class Sprite : public Image
@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2021 - 2022                                             *
+ *   Copyright (C) 2021 - 2026                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -23,7 +23,14 @@
 #include <cassert>
 #include <cstddef>
 
+// AVX2 is not a part of the baseline instruction set of any supported platform, so it is used only when the compiler is explicitly allowed to
+#if defined( __AVX2__ )
+#define FHEROES2_PALETTE_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
 #include "image_palette.h"
+#include "thread.h"
 
 namespace
 {
@@ -96,4 +103,63 @@ namespace fheroes2
 
         std::copy_n( palette.begin(), paletteSize, PaletteHolder::instance().gamePalette.begin() );
     }
+
+    void convertPaletteRow( const uint8_t * in, uint32_t * out, const int32_t width, const uint32_t * palette )
+    {
+        const uint32_t * outEnd = out + width;
+
+#if defined( FHEROES2_PALETTE_SIMD_AVX2 )
+        for ( ; outEnd - out >= 8; out += 8, in += 8 ) {
+            const __m256i indexes = _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i *>( in ) ) );
+            _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), _mm256_i32gather_epi32( reinterpret_cast<const int *>( palette ), indexes, 4 ) );
+        }
+#else
+        // There is no gather instruction in SSE2 and NEON. Table lookups of 4 pixels at once let the CPU execute independent loads in parallel.
+        for ( ; outEnd - out >= 4; out += 4, in += 4 ) {
+            const uint32_t value0 = palette[in[0]];
+            const uint32_t value1 = palette[in[1]];
+            const uint32_t value2 = palette[in[2]];
+            const uint32_t value3 = palette[in[3]];
+
+            out[0] = value0;
+            out[1] = value1;
+            out[2] = value2;
+            out[3] = value3;
+        }
+#endif
+
+        for ( ; out != outEnd; ++out, ++in ) {
+            *out = palette[*in];
+        }
+    }
+
+    void convertPaletteArea( const uint8_t * in, const int32_t inStride, uint32_t * out, const int32_t outStride, const int32_t width, const int32_t height,
+                             const uint32_t * palette )
+    {
+        // Conversion of smaller bands is not worth the synchronization of threads.
+        const size_t minPixelsPerBand = 256 * 1024;
+
+        const size_t bandCount = std::min( MultiThreading::getParallelThreadCount(), static_cast<size_t>( width ) * static_cast<size_t>( height ) / minPixelsPerBand );
+        if ( bandCount < 2 ) {
+            for ( int32_t y = 0; y < height; ++y, in += inStride, out += outStride ) {
+                convertPaletteRow( in, out, width, palette );
+            }
+
+            return;
+        }
+
+        const int32_t rowsPerBand = ( height + static_cast<int32_t>( bandCount ) - 1 ) / static_cast<int32_t>( bandCount );
+
+        MultiThreading::executeInParallel( bandCount, [in, inStride, out, outStride, width, height, palette, rowsPerBand]( const size_t bandId ) {
+            const int32_t startY = static_cast<int32_t>( bandId ) * rowsPerBand;
+            const int32_t endY = std::min( height, startY + rowsPerBand );
+
+            const uint8_t * inY = in + static_cast<ptrdiff_t>( startY ) * inStride;
+            uint32_t * outY = out + static_cast<ptrdiff_t>( startY ) * outStride;
+
+            for ( int32_t y = startY; y < endY; ++y, inY += inStride, outY += outStride ) {
+                convertPaletteRow( inY, outY, width, palette );
+            }
+        } );
+    }
 }
@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2021 - 2022                                             *
+ *   Copyright (C) 2021 - 2026                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -29,4 +29,11 @@ namespace fheroes2
 
     // This function must be called only at the start of the application after loading AGG file content.
     void setGamePalette( const std::vector<uint8_t> & palette );
+
+    // Converts a row of palette indexes into 32-bit pixels using the given palette lookup table of 256 values
+    void convertPaletteRow( const uint8_t * in, uint32_t * out, const int32_t width, const uint32_t * palette );
+
+    // Converts an area of palette indexes into 32-bit pixels. Big areas are split into bands of rows which are converted in parallel.
+    void convertPaletteArea( const uint8_t * in, const int32_t inStride, uint32_t * out, const int32_t outStride, const int32_t width, const int32_t height,
+                             const uint32_t * palette );
 }
@@ -21,9 +21,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <ostream>
 #include <set>
@@ -263,6 +265,68 @@ namespace
         return true;
     }
 
+    // Rendering of every separate area has its own overhead, so areas are merged together if the merged area contains not many extra pixels.
+    const int64_t renderAreaMergeThreshold = 64 * 64;
+
+    // Too many small areas are rendered as their bounding rectangle.
+    const size_t maxRenderAreaCount = 8;
+
+    int64_t getRectArea( const fheroes2::Rect & roi )
+    {
+        return static_cast<int64_t>( roi.width ) * roi.height;
+    }
+
+    bool isIntersecting( const fheroes2::Rect & first, const fheroes2::Rect & second )
+    {
+        return first.x < second.x + second.width && second.x < first.x + first.width && first.y < second.y + second.height && second.y < first.y + first.height;
+    }
+
+    // Adds the area to the list of areas to render keeping all areas in the list not intersecting each other.
+    void addRenderArea( std::vector<fheroes2::Rect> & areas, fheroes2::Rect roi )
+    {
+        if ( roi.width <= 0 || roi.height <= 0 ) {
+            return;
+        }
+
+        bool isMerged = true;
+        while ( isMerged ) {
+            isMerged = false;
+
+            for ( auto iter = areas.begin(); iter != areas.end(); ++iter ) {
+                const fheroes2::Rect boundary = fheroes2::getBoundaryRect( *iter, roi );
+                if ( isIntersecting( *iter, roi ) || getRectArea( boundary ) <= getRectArea( *iter ) + getRectArea( roi ) + renderAreaMergeThreshold ) {
+                    // The merged area can intersect other areas now, so all of them have to be checked again.
+                    roi = boundary;
+                    areas.erase( iter );
+                    isMerged = true;
+                    break;
+                }
+            }
+        }
+
+        if ( areas.size() < maxRenderAreaCount ) {
+            areas.push_back( roi );
+            return;
+        }
+
+        // Merge the new area with the one which gives the least number of extra pixels.
+        auto bestIter = areas.begin();
+        int64_t bestExtraArea = std::numeric_limits<int64_t>::max();
+
+        for ( auto iter = areas.begin(); iter != areas.end(); ++iter ) {
+            const int64_t extraArea = getRectArea( fheroes2::getBoundaryRect( *iter, roi ) ) - getRectArea( *iter ) - getRectArea( roi );
+            if ( extraArea < bestExtraArea ) {
+                bestExtraArea = extraArea;
+                bestIter = iter;
+            }
+        }
+
+        roi = fheroes2::getBoundaryRect( *bestIter, roi );
+        areas.erase( bestIter );
+
+        addRenderArea( areas, roi );
+    }
+
     const uint8_t * currentPalette = PALPalette();
 
 // If SDL library is used
@@ -293,13 +357,8 @@ namespace
 
             if ( fullFrame ) {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * out = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outEnd = out + imageWidth * imageHeight;
-                    const uint8_t * in = imageIn;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; out != outEnd; ++out, ++in )
-                        *out = *( transform + *in );
+                    fheroes2::convertPaletteArea( imageIn, imageWidth, static_cast<uint32_t *>( surface->pixels ), imageWidth, imageWidth, imageHeight,
+                                                  _palette32Bit.data() );
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
                     if ( imageWidth % 4 != 0 ) {
@@ -315,19 +374,8 @@ namespace
             }
             else {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * outY = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outYEnd = outY + imageWidth * roi.height;
-                    const uint8_t * inY = imageIn + roi.x + roi.y * imageWidth;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; outY != outYEnd; outY += imageWidth, inY += imageWidth ) {
-                        uint32_t * outX = outY;
-                        const uint32_t * outXEnd = outX + roi.width;
-                        const uint8_t * inX = inY;
-
-                        for ( ; outX != outXEnd; ++outX, ++inX )
-                            *outX = *( transform + *inX );
-                    }
+                    fheroes2::convertPaletteArea( imageIn + roi.x + roi.y * imageWidth, imageWidth, static_cast<uint32_t *>( surface->pixels ), imageWidth, roi.width,
+                                                  roi.height, _palette32Bit.data() );
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
                     const int32_t screenWidth = ( imageWidth / 4 ) * 4 + 4;
@@ -1126,6 +1174,28 @@ namespace
 
             assert( _renderer != nullptr && _texture != nullptr );
 
+            _updateTexture( display, roi );
+            _present();
+        }
+
+        void renderAreas( const fheroes2::Display & display, const std::vector<fheroes2::Rect> & areas ) override
+        {
+            if ( _surface == nullptr ) {
+                return;
+            }
+
+            assert( _renderer != nullptr && _texture != nullptr );
+
+            // Only the pixels of the given areas are converted and uploaded to the texture, but the whole texture is presented on screen.
+            for ( const fheroes2::Rect & roi : areas ) {
+                _updateTexture( display, roi );
+            }
+
+            _present();
+        }
+
+        void _updateTexture( const fheroes2::Display & display, const fheroes2::Rect & roi )
+        {
             copyImageToSurface( display, _surface, roi );
 
             const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
@@ -1147,7 +1217,10 @@ namespace
                     ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
                 }
             }
+        }
 
+        void _present()
+        {
             int returnCode = SDL_RenderClear( _renderer );
             if ( returnCode < 0 ) {
                 ERROR_LOG( "Failed to clear renderer. The error value: " << returnCode << ", description: " << SDL_GetError() )
@@ -1439,6 +1512,16 @@ namespace fheroes2
         Display::instance().linkRenderSurface( surface );
     }
 
+    void BaseRenderEngine::renderAreas( const Display & display, const std::vector<Rect> & areas )
+    {
+        Rect roi;
+        for ( const Rect & area : areas ) {
+            roi = getBoundaryRect( roi, area );
+        }
+
+        render( display, roi );
+    }
+
     Display::Display()
         : _engine( RenderEngine::create() )
         , _cursor( RenderCursor::create() )
@@ -1467,7 +1550,7 @@ namespace fheroes2
         // deallocate engine resources
         _engine->clear();
 
-        _prevRoi = {};
+        _prevRois.clear();
 
         // allocate engine resources
         if ( !_engine->allocate( info, isFullScreen ) ) {
@@ -1487,7 +1570,7 @@ namespace fheroes2
         // deallocate engine resources
         _engine->clear();
 
-        _prevRoi = {};
+        _prevRois.clear();
 
         ResolutionInfo res( width(), height(), _screenSize.width, _screenSize.height );
 
@@ -1515,6 +1598,8 @@ namespace fheroes2
             return;
         }
 
+        std::vector<Rect> currentAreas{ temp };
+
         if ( _cursor->isVisible() && _cursor->isSoftwareEmulation() && !_cursor->_image.empty() ) {
             const Sprite & cursorImage = _cursor->_image;
             Rect cursorROI( cursorImage.x(), cursorImage.y(), cursorImage.width(), cursorImage.height() );
@@ -1529,10 +1614,10 @@ namespace fheroes2
 
             // ROI must include cursor's area as well, otherwise cursor won't be rendered.
             if ( !backup.empty() && getActiveArea( cursorROI, width(), height() ) ) {
-                temp = getBoundaryRect( temp, cursorROI );
+                addRenderArea( currentAreas, cursorROI );
             }
 
-            _renderFrame( temp );
+            _renderFrame( currentAreas );
 
             if ( _postprocessing ) {
                 _postprocessing();
@@ -1541,23 +1626,25 @@ namespace fheroes2
             Copy( backup, 0, 0, *this, backup.x(), backup.y(), backup.width(), backup.height() );
         }
         else {
-            _renderFrame( temp );
+            _renderFrame( currentAreas );
 
             if ( _postprocessing ) {
                 _postprocessing();
             }
         }
 
-        _prevRoi = temp;
+        _prevRois = std::move( currentAreas );
     }
 
     void Display::updateNextRenderRoi( const Rect & roi )
     {
-        _prevRoi = getBoundaryRect( _prevRoi, roi );
-        getActiveArea( _prevRoi, width(), height() );
+        Rect temp( roi );
+        if ( getActiveArea( temp, width(), height() ) ) {
+            addRenderArea( _prevRois, temp );
+        }
     }
 
-    void Display::_renderFrame( const Rect & roi ) const
+    void Display::_renderFrame( const std::vector<Rect> & areas ) const
     {
         bool updateImage = true;
         if ( _preprocessing ) {
@@ -1574,10 +1661,34 @@ namespace fheroes2
             }
         }
 
-        if ( updateImage ) {
-            // Make sure that we update the previously rendered area to avoid any ghost effect artefacts.
-            _engine->render( *this, getBoundaryRect( roi, _prevRoi ) );
+        if ( !updateImage ) {
+            return;
+        }
+
+        // Make sure that we update the previously rendered areas to avoid any ghost effect artefacts.
+        std::vector<Rect> renderAreas( _prevRois );
+        for ( const Rect & area : areas ) {
+            addRenderArea( renderAreas, area );
+        }
+
+        if ( renderAreas.size() == 1 ) {
+            _engine->render( *this, renderAreas.front() );
+            return;
+        }
+
+        int64_t totalArea = 0;
+        for ( const Rect & area : renderAreas ) {
+            totalArea += getRectArea( area );
         }
+
+        // When the most of the frame is fragmented into many areas it is faster to update the whole frame at once.
+        const Rect frameRoi{ 0, 0, width(), height() };
+        if ( totalArea * 2 >= getRectArea( frameRoi ) ) {
+            _engine->render( *this, frameRoi );
+            return;
+        }
+
+        _engine->renderAreas( *this, renderAreas );
     }
 
     uint8_t * Display::image()
@@ -1596,7 +1707,7 @@ namespace fheroes2
         _cursor.reset();
         clear();
 
-        _prevRoi = {};
+        _prevRois.clear();
     }
 
     void Display::changePalette( const uint8_t * palette, const bool forceDefaultPaletteUpdate ) const
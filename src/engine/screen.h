@@ -167,6 +167,10 @@ namespace fheroes2
             // Do nothing.
         }
 
+        // Render a frame updating only the given areas of it. The areas must not intersect each other.
+        // By default all the areas are rendered as one bounding rectangle.
+        virtual void renderAreas( const Display & display, const std::vector<Rect> & areas ); // declaration of this method is in source file
+
         virtual bool allocate( ResolutionInfo & /*unused*/, bool /*unused*/ )
         {
             return false;
@@ -274,8 +278,9 @@ namespace fheroes2
 
         uint8_t * _renderSurface{ nullptr };
 
-        // Previous area drawn on the screen.
-        Rect _prevRoi;
+        // Areas drawn on the screen by the previous render() call and areas requested by updateNextRenderRoi() since then.
+        // They do not intersect each other.
+        std::vector<Rect> _prevRois;
 
         Size _screenSize;
 
@@ -287,7 +292,7 @@ namespace fheroes2
 
         Display();
 
-        void _renderFrame( const Rect & roi ) const; // prepare and render a frame
+        void _renderFrame( const std::vector<Rect> & areas ) const; // prepare and render a frame
     };
 
     class Cursor
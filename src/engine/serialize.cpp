@@ -270,6 +270,16 @@ void RWStreamBuf::putRaw( const void * ptr, size_t size )
         return;
     }
 
+    uint8_t * dst = putRawView( size );
+    if ( dst == nullptr ) {
+        return;
+    }
+
+    memcpy( dst, ptr, size );
+}
+
+uint8_t * RWStreamBuf::putRawView( const size_t size )
+{
     if ( sizep() < size ) {
         if ( size < capacity() / 2 ) {
             reallocBuf( capacity() + capacity() / 2 );
@@ -281,12 +291,14 @@ void RWStreamBuf::putRaw( const void * ptr, size_t size )
 
     if ( sizep() < size ) {
         assert( 0 );
-        return;
+        return nullptr;
     }
 
-    memcpy( _itput, ptr, size );
+    uint8_t * view = _itput;
 
     _itput = _itput + size;
+
+    return view;
 }
 
 void RWStreamBuf::put8( const uint8_t v )
@@ -366,6 +378,16 @@ ROStreamBuf::ROStreamBuf( const std::vector<uint8_t> & buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+ROStreamBuf::ROStreamBuf( const uint8_t * data, const size_t size )
+{
+    _itbeg = data;
+    _itend = _itbeg + size;
+    _itget = _itbeg;
+    _itput = _itend;
+
+    setBigendian( IS_BIGENDIAN );
+}
+
 ROStreamBuf::ROStreamBuf( std::vector<uint8_t> && buf )
     : _buf( std::move( buf ) )
 {
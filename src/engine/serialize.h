@@ -580,6 +580,10 @@ public:
 
     void putRaw( const void * ptr, size_t size ) override;
 
+    // Moves the write position forward by the given number of bytes and returns a pointer to the skipped memory, which must be filled
+    // by the caller. This allows to write data directly to the buffer. Returns nullptr if the memory cannot be allocated.
+    uint8_t * putRawView( const size_t size );
+
 private:
     void put8( const uint8_t v ) override;
 
@@ -597,6 +601,8 @@ class ROStreamBuf final : public StreamBufTmpl<const uint8_t>
 public:
     // Creates a non-owning stream on top of an external buffer ("view mode")
     explicit ROStreamBuf( const std::vector<uint8_t> & buf );
+    // Creates a non-owning stream on top of an external memory block ("view mode")
+    ROStreamBuf( const uint8_t * data, const size_t size );
     // Takes ownership of the given buffer (through the move operation) and creates a stream on top of it
     explicit ROStreamBuf( std::vector<uint8_t> && buf );
 
@@ -24,6 +24,7 @@
 #include "system.h"
 
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <map>
@@ -451,6 +452,32 @@ bool System::IsDirectory( const std::string_view path )
     return std::filesystem::is_directory( correctedPath, ec );
 }
 
+bool System::GetFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime )
+{
+    std::string correctedPath;
+    if ( !GetCaseInsensitivePath( path, correctedPath ) ) {
+        return false;
+    }
+
+    std::error_code ec;
+
+    // Using the non-throwing overloads
+    const uintmax_t fileSize = std::filesystem::file_size( correctedPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type fileTime = std::filesystem::last_write_time( correctedPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>( fileSize );
+    modificationTime = static_cast<int64_t>( fileTime.time_since_epoch().count() );
+
+    return true;
+}
+
 bool System::GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath )
 {
 #if !defined( _WIN32 ) && !defined( ANDROID ) && !defined( TARGET_PS_VITA ) && !defined( __IPHONEOS__ )
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <filesystem>
 #include <string>
@@ -64,6 +65,10 @@ namespace System
     bool IsFile( const std::string_view path );
     bool IsDirectory( const std::string_view path );
 
+    // Gets the size and the last modification time of the file. The modification time is only meaningful when compared with
+    // another modification time returned by this function. Returns false if the file does not exist or cannot be accessed.
+    bool GetFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2022 - 2025                                             *
+ *   Copyright (C) 2022 - 2026                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -20,12 +20,165 @@
 
 #include "thread.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
-#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
 namespace
 {
+    // The maximum number of threads used to execute parallel tasks. Tasks executed in parallel are usually limited by memory
+    // bandwidth, so there is no point in using too many threads.
+    const size_t maxParallelThreadCount = 8;
+
+    // Is set for the worker threads of the pool as well as for the threads that are currently executing parallel tasks
+    thread_local bool isExecutingParallelTasks = false;
+
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+    class ParallelTaskPool
+    {
+    public:
+        ParallelTaskPool()
+        {
+            const size_t threadCount = std::clamp( static_cast<size_t>( std::thread::hardware_concurrency() ), static_cast<size_t>( 1 ), maxParallelThreadCount );
+
+            _workers.reserve( threadCount - 1 );
+
+            for ( size_t i = 1; i < threadCount; ++i ) {
+                _workers.emplace_back( &ParallelTaskPool::_workerThread, this );
+            }
+        }
+
+        ParallelTaskPool( const ParallelTaskPool & ) = delete;
+
+        ~ParallelTaskPool()
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _exitFlag = true;
+            }
+
+            _workerNotification.notify_all();
+
+            for ( std::thread & worker : _workers ) {
+                worker.join();
+            }
+        }
+
+        ParallelTaskPool & operator=( const ParallelTaskPool & ) = delete;
+
+        size_t getThreadCount() const
+        {
+            return _workers.size() + 1;
+        }
+
+        void execute( const size_t taskCount, const std::function<void( const size_t )> & task )
+        {
+            // Only one set of tasks can be executed at a time
+            const std::scoped_lock<std::mutex> executionLock( _executionMutex );
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _task = &task;
+                _taskCount = taskCount;
+                _nextTaskIndex = 0;
+                ++_generation;
+            }
+
+            _workerNotification.notify_all();
+
+            // The calling thread participates in the execution of tasks as well
+            _executeTasks( task, taskCount );
+
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            // All the tasks have already been taken for execution, wait for the workers to complete them
+            _masterNotification.wait( lock, [this] { return _activeWorkerCount == 0; } );
+
+            _task = nullptr;
+            _taskCount = 0;
+        }
+
+    private:
+        std::vector<std::thread> _workers;
+
+        std::mutex _executionMutex;
+        std::mutex _mutex;
+
+        std::condition_variable _masterNotification;
+        std::condition_variable _workerNotification;
+
+        const std::function<void( const size_t )> * _task{ nullptr };
+        size_t _taskCount{ 0 };
+        std::atomic<size_t> _nextTaskIndex{ 0 };
+
+        uint64_t _generation{ 0 };
+        size_t _activeWorkerCount{ 0 };
+        bool _exitFlag{ false };
+
+        void _executeTasks( const std::function<void( const size_t )> & task, const size_t taskCount )
+        {
+            for ( size_t taskIndex = _nextTaskIndex++; taskIndex < taskCount; taskIndex = _nextTaskIndex++ ) {
+                task( taskIndex );
+            }
+        }
+
+        static void _workerThread( ParallelTaskPool * pool )
+        {
+            assert( pool != nullptr );
+
+            isExecutingParallelTasks = true;
+
+            uint64_t lastGeneration = 0;
+
+            while ( true ) {
+                const std::function<void( const size_t )> * task = nullptr;
+                size_t taskCount = 0;
+
+                {
+                    std::unique_lock<std::mutex> lock( pool->_mutex );
+
+                    pool->_workerNotification.wait( lock, [pool, lastGeneration] {
+                        return pool->_exitFlag || ( pool->_task != nullptr && pool->_generation != lastGeneration );
+                    } );
+
+                    if ( pool->_exitFlag ) {
+                        break;
+                    }
+
+                    lastGeneration = pool->_generation;
+
+                    task = pool->_task;
+                    taskCount = pool->_taskCount;
+
+                    ++pool->_activeWorkerCount;
+                }
+
+                pool->_executeTasks( *task, taskCount );
+
+                {
+                    const std::scoped_lock<std::mutex> lock( pool->_mutex );
+
+                    --pool->_activeWorkerCount;
+                }
+
+                pool->_masterNotification.notify_one();
+            }
+        }
+    };
+
+    ParallelTaskPool & getParallelTaskPool()
+    {
+        static ParallelTaskPool pool;
+
+        return pool;
+    }
+#endif
+
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
     class MutexUnlocker
     {
     public:
@@ -47,8 +200,8 @@ namespace
     private:
         std::mutex & _mutex;
     };
-}
 #endif
+}
 
 namespace MultiThreading
 {
@@ -150,4 +303,36 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    size_t getParallelThreadCount()
+    {
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+        return 1;
+#else
+        return getParallelTaskPool().getThreadCount();
+#endif
+    }
+
+    void executeInParallel( const size_t taskCount, const std::function<void( const size_t )> & task )
+    {
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+        if ( taskCount > 1 && !isExecutingParallelTasks ) {
+            ParallelTaskPool & pool = getParallelTaskPool();
+
+            if ( pool.getThreadCount() > 1 ) {
+                isExecutingParallelTasks = true;
+
+                pool.execute( taskCount, task );
+
+                isExecutingParallelTasks = false;
+
+                return;
+            }
+        }
+#endif
+
+        for ( size_t i = 0; i < taskCount; ++i ) {
+            task( i );
+        }
+    }
 }
@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2022 - 2025                                             *
+ *   Copyright (C) 2022 - 2026                                             *
  *                                                                         *
  *   This program is free software; you can redistribute it and/or modify  *
  *   it under the terms of the GNU General Public License as published by  *
@@ -22,6 +22,8 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -70,4 +72,13 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // Returns the number of threads (including the calling thread) that are used by executeInParallel() to execute tasks.
+    size_t getParallelThreadCount();
+
+    // Executes the task for each index in the range [0, taskCount) using a pool of worker threads along with the calling thread
+    // and waits for all of them to complete. The order in which the indexes are processed is not defined, so the tasks should be
+    // independent of each other and should not modify any shared state. Nested calls (from within a task) as well as calls from
+    // multiple threads at the same time are allowed, but they are executed sequentially.
+    void executeInParallel( const size_t taskCount, const std::function<void( const size_t )> & task );
 }
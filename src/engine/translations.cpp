@@ -64,7 +64,7 @@ namespace
         return table;
     }
 
-    const std::array<uint32_t, 256> crc32Table = getCRC32Table();
+    constexpr std::array<uint32_t, 256> crc32Table = getCRC32Table();
 
     // Character lookup table for custom tolower
     // Compatible with ASCII, custom French encoding, CP1250 and CP1251
@@ -297,7 +297,7 @@ namespace
         return iter->second;
     }
 
-    uint32_t crc32b( const std::string_view str )
+    constexpr uint32_t crc32b( const std::string_view str )
     {
         uint32_t crc = 0xFFFFFFFF;
 
@@ -308,6 +308,10 @@ namespace
         return ~crc;
     }
 
+    // Hashes of messages calculated at compile time must match the ones used in translation files.
+    static_assert( crc32b( "Turn %{turn}" ) == Translation::getMessageHash( "Turn %{turn}" ) );
+    static_assert( crc32b( "\xC9t\xE9" ) == Translation::getMessageHash( "\xC9t\xE9" ) );
+
     bool getCharsetFromHeader( const std::string & hdr, std::string & charset )
     {
         constexpr std::string_view hdrEntry{ "Content-Type:" };
@@ -345,13 +349,20 @@ namespace
 
         const char * ngettext( const char * str, const size_t plural ) const
         {
+            return ngettext( str, crc32b( str ), plural );
+        }
+
+        const char * ngettext( const char * str, const uint32_t hash, const size_t plural ) const
+        {
+            assert( hash == crc32b( str ) );
+
             if ( !_isValid ) {
                 assert( 0 );
 
                 return stripContext( str );
             }
 
-            const auto iter = std::as_const( _translations ).find( crc32b( str ) );
+            const auto iter = std::as_const( _translations ).find( hash );
             if ( iter == _translations.cend() ) {
                 return stripContext( str );
             }
@@ -561,8 +572,54 @@ namespace
         bool _isValid{ false };
     };
 
+    // The maximum number of translations memoized by every thread.
+    const size_t maxMemoizedTranslations = 8192;
+
     MOFile * current = nullptr;
+    // Changes every time the current language is changed, so that memoized translations are not used anymore.
+    uint32_t currentLanguageId = 0;
+
     std::map<std::string, MOFile, std::less<>> cache;
+
+    struct MemoizedTranslation
+    {
+        // The message is kept to make sure that its address still points to the same message, which is not guaranteed for strings
+        // that are not literals. Comparing strings is much faster than hashing them.
+        std::string message;
+        const char * translation{ nullptr };
+    };
+
+    void setCurrentLanguage( MOFile * item )
+    {
+        if ( item != current ) {
+            current = item;
+            ++currentLanguageId;
+        }
+    }
+
+    const char * getMemoizedTranslation( const char * str )
+    {
+        assert( current != nullptr );
+
+        // Messages can be translated by parallel tasks, so every thread has its own cache.
+        thread_local std::unordered_map<const char *, MemoizedTranslation> translations;
+        thread_local uint32_t translationsLanguageId = 0;
+
+        // Temporary strings can fill the cache with addresses which are never used again, so it is reset when it grows too much.
+        if ( translationsLanguageId != currentLanguageId || translations.size() >= maxMemoizedTranslations ) {
+            translations.clear();
+            translationsLanguageId = currentLanguageId;
+        }
+
+        MemoizedTranslation & item = translations[str];
+
+        if ( item.translation == nullptr || item.message != str ) {
+            item.message = str;
+            item.translation = current->ngettext( str, 0 );
+        }
+
+        return item.translation;
+    }
 }
 
 std::pair<bool, bool> Translation::setLanguage( const std::string_view langName )
@@ -573,7 +630,7 @@ std::pair<bool, bool> Translation::setLanguage( const std::string_view langName
         MOFile & item = iter->second;
 
         if ( item.isValid() ) {
-            current = &item;
+            setCurrentLanguage( &item );
         }
 
         return { true, item.isValid() };
@@ -591,7 +648,7 @@ bool Translation::setLanguage( const std::string & langName, const std::string_v
 
     if ( !inserted ) {
         if ( item.isValid() ) {
-            current = &item;
+            setCurrentLanguage( &item );
         }
 
         return item.isValid();
@@ -605,14 +662,14 @@ bool Translation::setLanguage( const std::string & langName, const std::string_v
 
     assert( item.isValid() );
 
-    current = &item;
+    setCurrentLanguage( &item );
 
     return true;
 }
 
 void Translation::reset()
 {
-    current = nullptr;
+    setCurrentLanguage( nullptr );
 }
 
 const char * Translation::gettext( const std::string & str )
@@ -622,7 +679,12 @@ const char * Translation::gettext( const std::string & str )
 
 const char * Translation::gettext( const char * str )
 {
-    return current ? current->ngettext( str, 0 ) : stripContext( str );
+    return current ? getMemoizedTranslation( str ) : stripContext( str );
+}
+
+const char * Translation::gettext( const char * str, const uint32_t hash )
+{
+    return current ? current->ngettext( str, hash, 0 ) : stripContext( str );
 }
 
 const char * Translation::getNonTranslated( const char * str )
@@ -24,8 +24,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace Translation
@@ -46,8 +48,31 @@ namespace Translation
     // Resets the current language to the default language (English).
     void reset();
 
+    // Returns the hash of the given message which is used to look up its translation. It is slower than the one used at runtime
+    // and is intended for calculating hashes of string literals at compile time (see the _h() macro).
+    constexpr uint32_t getMessageHash( const std::string_view str )
+    {
+        uint32_t crc = 0xFFFFFFFF;
+
+        for ( const char ch : str ) {
+            crc ^= static_cast<uint8_t>( ch );
+
+            for ( int bit = 0; bit < 8; ++bit ) {
+                crc = ( crc & 1 ) ? ( ( crc >> 1 ) ^ 0xEDB88320 ) : ( crc >> 1 );
+            }
+        }
+
+        return ~crc;
+    }
+
+    // Translations are memoized by the address of the message, so the same string literal is not hashed again on every call.
     const char * gettext( const char * str );
+
     const char * gettext( const std::string & str );
+
+    // The hash must be calculated by getMessageHash() from the same message.
+    const char * gettext( const char * str, const uint32_t hash );
+
     const char * ngettext( const char * str, const char * plural, const size_t n );
 
     // Converts the given string to lowercase in a locale aware way
@@ -58,6 +83,8 @@ namespace Translation
 }
 
 #define _( str ) Translation::gettext( str )
+// Only for string literals: the hash of the message is calculated at compile time. Use it for messages that are translated on every frame.
+#define _h( str ) Translation::gettext( str, std::integral_constant<uint32_t, Translation::getMessageHash( str )>::value )
 #define _n( str, plural, num ) Translation::ngettext( str, plural, num )
 
 constexpr const char * gettext_noop( const char * s )
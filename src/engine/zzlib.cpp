@@ -23,6 +23,9 @@
 
 #include "zzlib.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cstring>
 #include <ostream>
 
@@ -31,10 +34,77 @@
 
 #include "logging.h"
 #include "serialize.h"
+#include "thread.h"
 
 namespace
 {
+    // A single zlib stream.
     constexpr uint16_t FORMAT_VERSION_0 = 0;
+    // A table of blocks followed by independently compressed blocks.
+    constexpr uint16_t FORMAT_VERSION_1 = 1;
+
+    // Each block entry consists of its uncompressed size and its compressed size.
+    constexpr size_t blockEntrySize = 8;
+
+    bool unzipBlock( const uint8_t * src, const size_t srcSize, uint8_t * dst, const size_t dstSize )
+    {
+        const uLong srcSizeULong = static_cast<uLong>( srcSize );
+        uLong dstSizeULong = static_cast<uLong>( dstSize );
+        if ( srcSizeULong != srcSize || dstSizeULong != dstSize ) {
+            return false;
+        }
+
+        return uncompress( dst, &dstSizeULong, src, srcSizeULong ) == Z_OK && dstSizeULong == dstSize;
+    }
+
+    bool unzipBlocks( IStreamBase & inputStream, RWStreamBuf & outputStream, const uint32_t rawSize, const uint32_t zipSize )
+    {
+        const uint32_t blockCount = inputStream.get32();
+        if ( blockCount == 0 || zipSize < 4 || blockCount > ( zipSize - 4 ) / blockEntrySize ) {
+            return false;
+        }
+
+        // The offsets of the blocks in both the compressed and the uncompressed data are restored from the table
+        // so that every block can be decompressed independently of others.
+        std::vector<size_t> rawOffsets( blockCount + 1, 0 );
+        std::vector<size_t> zipOffsets( blockCount + 1, 0 );
+
+        for ( uint32_t i = 0; i < blockCount; ++i ) {
+            rawOffsets[i + 1] = rawOffsets[i] + inputStream.get32();
+            zipOffsets[i + 1] = zipOffsets[i] + inputStream.get32();
+        }
+
+        if ( inputStream.fail() ) {
+            return false;
+        }
+
+        const size_t blockDataSize = zipSize - 4 - blockCount * blockEntrySize;
+        if ( rawOffsets.back() != rawSize || zipOffsets.back() != blockDataSize ) {
+            return false;
+        }
+
+        const std::vector<uint8_t> zip = inputStream.getRaw( blockDataSize );
+        if ( zip.size() != blockDataSize ) {
+            return false;
+        }
+
+        // Blocks are decompressed directly to the memory of the output stream, each block to its own part of it.
+        uint8_t * raw = outputStream.putRawView( rawSize );
+        if ( raw == nullptr ) {
+            return false;
+        }
+
+        std::atomic<bool> isFailed{ false };
+
+        MultiThreading::executeInParallel( blockCount, [&zip, raw, &rawOffsets, &zipOffsets, &isFailed]( const size_t blockId ) {
+            if ( !unzipBlock( zip.data() + zipOffsets[blockId], zipOffsets[blockId + 1] - zipOffsets[blockId], raw + rawOffsets[blockId],
+                              rawOffsets[blockId + 1] - rawOffsets[blockId] ) ) {
+                isFailed = true;
+            }
+        } );
+
+        return !isFailed;
+    }
 }
 
 std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t srcSize, size_t realSize /* = 0 */ )
@@ -132,7 +202,7 @@ std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t src
     return res;
 }
 
-bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputStream )
+bool Compression::unzipStream( IStreamBase & inputStream, RWStreamBuf & outputStream )
 {
     const uint32_t rawSize = inputStream.get32();
     const uint32_t zipSize = inputStream.get32();
@@ -141,12 +211,16 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
     }
 
     const uint16_t version = inputStream.get16();
-    if ( version != FORMAT_VERSION_0 ) {
+    if ( version != FORMAT_VERSION_0 && version != FORMAT_VERSION_1 ) {
         return false;
     }
 
     inputStream.skip( 2 ); // Unused bytes
 
+    if ( version == FORMAT_VERSION_1 ) {
+        return unzipBlocks( inputStream, outputStream, rawSize, zipSize );
+    }
+
     const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
     const std::vector<uint8_t> raw = unzipData( zip.data(), zip.size(), rawSize );
     if ( raw.size() != rawSize ) {
@@ -174,6 +248,52 @@ bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & ou
     return !outputStream.fail();
 }
 
+bool Compression::zipStreamBufInBlocks( const IStreamBuf & inputStream, OStreamBase & outputStream, const size_t blockSize )
+{
+    assert( blockSize > 0 );
+
+    const uint8_t * data = inputStream.data();
+    const size_t dataSize = inputStream.size();
+    if ( dataSize == 0 ) {
+        return false;
+    }
+
+    const size_t blockCount = ( dataSize + blockSize - 1 ) / blockSize;
+
+    std::vector<std::vector<uint8_t>> zipBlocks( blockCount );
+
+    MultiThreading::executeInParallel( blockCount, [data, dataSize, blockSize, &zipBlocks]( const size_t blockId ) {
+        const size_t offset = blockId * blockSize;
+        zipBlocks[blockId] = zipData( data + offset, std::min( blockSize, dataSize - offset ), false );
+    } );
+
+    size_t zipSize = 4 + blockCount * blockEntrySize;
+    for ( const std::vector<uint8_t> & zip : zipBlocks ) {
+        if ( zip.empty() ) {
+            return false;
+        }
+
+        zipSize += zip.size();
+    }
+
+    outputStream.put32( static_cast<uint32_t>( dataSize ) );
+    outputStream.put32( static_cast<uint32_t>( zipSize ) );
+    outputStream.put16( FORMAT_VERSION_1 );
+    outputStream.put16( 0 ); // Unused bytes
+
+    outputStream.put32( static_cast<uint32_t>( blockCount ) );
+    for ( size_t i = 0; i < blockCount; ++i ) {
+        outputStream.put32( static_cast<uint32_t>( std::min( blockSize, dataSize - i * blockSize ) ) );
+        outputStream.put32( static_cast<uint32_t>( zipBlocks[i].size() ) );
+    }
+
+    for ( const std::vector<uint8_t> & zip : zipBlocks ) {
+        outputStream.putRaw( zip.data(), zip.size() );
+    }
+
+    return !outputStream.fail();
+}
+
 fheroes2::Image Compression::CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer )
 {
     if ( imageData == nullptr || imageSize == 0 || width <= 0 || height <= 0 ) {
@@ -32,6 +32,7 @@
 class IStreamBase;
 class OStreamBase;
 class IStreamBuf;
+class RWStreamBuf;
 
 namespace Compression
 {
@@ -47,12 +48,17 @@ namespace Compression
 
     // Reads & unzips the zipped chunk from the given input stream and writes it to the given output
     // stream. Returns true on success or false on error.
-    bool unzipStream( IStreamBase & inputStream, OStreamBase & outputStream );
+    bool unzipStream( IStreamBase & inputStream, RWStreamBuf & outputStream );
 
     // Zips the contents of the buffer from the current read position to the end of the buffer and writes
     // it to the given output stream. The current read position of the buffer does not change. Returns
     // true on success and false on error.
     bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream );
 
+    // Does the same as zipStreamBuf() but splits the data into blocks of the given size which are compressed independently
+    // by multiple threads. Such data is read by unzipStream() which decompresses the blocks in parallel as well. Older
+    // versions of the engine are unable to read it so use it only for data that has its own format versioning.
+    bool zipStreamBufInBlocks( const IStreamBuf & inputStream, OStreamBase & outputStream, const size_t blockSize );
+
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 }
@@ -27,6 +27,7 @@
 
 #include "agg.h"
 #include "agg_file.h"
+#include "agg_image.h"
 #include "dir.h"
 #include "settings.h"
 #include "tools.h"
@@ -37,14 +38,14 @@ namespace
     fheroes2::AGGFile heroes2x_agg;
 }
 
-std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
+fheroes2::AGGFileData AGG::getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
 {
     if ( !ignoreExpansion && heroes2x_agg.isGood() ) {
-        // Make sure that the below container is not const and not a reference
-        // so returning it from the function will invoke a move constructor instead of copy constructor.
-        std::vector<uint8_t> buf = heroes2x_agg.read( key );
-        if ( !buf.empty() )
-            return buf;
+        // Make sure that the below object is not const so returning it from the function will invoke a move constructor.
+        fheroes2::AGGFileData data = heroes2x_agg.read( key );
+        if ( !data.empty() ) {
+            return data;
+        }
     }
 
     return heroes2_agg.read( key );
@@ -59,6 +60,11 @@ AGG::AGGInitializer::AGGInitializer()
     throw std::logic_error( "No AGG data files found." );
 }
 
+AGG::AGGInitializer::~AGGInitializer()
+{
+    fheroes2::AGG::stopICNPrefetching();
+}
+
 bool AGG::AGGInitializer::init()
 {
     const ListFiles aggFileNames = Settings::FindFiles( "data", ".agg", false );
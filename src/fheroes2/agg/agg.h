@@ -23,9 +23,9 @@
 
 #pragma once
 
-#include <cstdint>
 #include <string>
-#include <vector>
+
+#include "agg_file.h"
 
 namespace AGG
 {
@@ -36,7 +36,7 @@ namespace AGG
         AGGInitializer( const AGGInitializer & ) = delete;
         AGGInitializer & operator=( const AGGInitializer & ) = delete;
 
-        ~AGGInitializer() = default;
+        ~AGGInitializer();
 
         const std::string & getOriginalAGGFilePath() const
         {
@@ -55,7 +55,8 @@ namespace AGG
         std::string _expansionAGGFilePath;
     };
 
-    std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+    // Returned data is a view of the memory-mapped AGG file on most platforms, so there is no need to cache it.
+    fheroes2::AGGFileData getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
 
     // Only for internal usage within AGG namespace.
     bool isPoLResourceFilePresent();
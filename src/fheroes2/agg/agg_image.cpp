@@ -24,10 +24,15 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <exception>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -43,11 +48,15 @@
 #include "icn.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
+#include "monster.h"
+#include "monster_info.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
+#include "thread.h"
 #include "til.h"
 #include "tools.h"
 #include "translations.h"
@@ -69,6 +78,34 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    struct ICNCacheInfo
+    {
+        // Approximate amount of memory used by decoded sprites of this ICN.
+        size_t memoryUsage{ 0 };
+
+        // Value of the access counter at the time of the last access to this ICN.
+        uint64_t lastAccess{ 0 };
+
+        // The ICN was used to generate another ICN or other ICNs were used to generate it. Such ICNs are never evicted from the cache
+        // because generation of ICNs can modify sprites of other ICNs and is not designed to be done more than once.
+        bool isGenerationDependent{ false };
+    };
+
+    std::vector<ICNCacheInfo> _icnCacheInfo( ICN::LASTICN );
+    uint64_t _icnAccessCounter{ 0 };
+
+    fheroes2::AGG::ICNCacheStatistics _icnCacheStatistics;
+
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+    // These platforms have a very limited amount of memory.
+    size_t _icnCacheMemoryLimit{ 64 * 1024 * 1024 };
+#else
+    size_t _icnCacheMemoryLimit{ 256 * 1024 * 1024 };
+#endif
+
+    // ICNs which are being loaded at the moment. An ICN can be loaded while loading another ICN if it is used to generate this ICN.
+    std::vector<int> _icnLoadingStack;
+
     // Some resources are language dependent. These are mostly buttons with a text of them.
     // Once a user changes a language we have to update resources. To do this we need to clear the existing images.
 
@@ -185,6 +222,121 @@ namespace
         return languageDependentIcnId.count( id ) > 0;
     }
 
+    // Sprites of these ICNs are drawn on the Adventure Map many times per frame, and most of their pixels are transparent,
+    // so they are drawn using pixel spans (see fheroes2::Image::buildSpans())
+    const std::set<int> spanDrawingIcnId{ ICN::BOAT32,
+                                          ICN::EXTRAOVR,
+                                          ICN::FLAG32,
+                                          ICN::MINIHERO,
+                                          ICN::MONS32,
+                                          ICN::MTNCRCK,
+                                          ICN::MTNDIRT,
+                                          ICN::MTNDSRT,
+                                          ICN::MTNGRAS,
+                                          ICN::MTNLAVA,
+                                          ICN::MTNMULT,
+                                          ICN::MTNSNOW,
+                                          ICN::MTNSWMP,
+                                          ICN::OBJNARTI,
+                                          ICN::OBJNCRCK,
+                                          ICN::OBJNDIRT,
+                                          ICN::OBJNDSRT,
+                                          ICN::OBJNGRA2,
+                                          ICN::OBJNGRAS,
+                                          ICN::OBJNLAV2,
+                                          ICN::OBJNLAV3,
+                                          ICN::OBJNLAVA,
+                                          ICN::OBJNMUL2,
+                                          ICN::OBJNMULT,
+                                          ICN::OBJNRSRC,
+                                          ICN::OBJNSNOW,
+                                          ICN::OBJNSWMP,
+                                          ICN::OBJNTOWN,
+                                          ICN::OBJNTWBA,
+                                          ICN::OBJNTWRD,
+                                          ICN::OBJNTWSH,
+                                          ICN::OBJNWAT2,
+                                          ICN::OBJNWATR,
+                                          ICN::OBJNXTRA,
+                                          ICN::ROAD,
+                                          ICN::STREAM,
+                                          ICN::TREDECI,
+                                          ICN::TREEVIL,
+                                          ICN::TREFALL,
+                                          ICN::TREFIR,
+                                          ICN::TREJNGL,
+                                          ICN::TRESNOW,
+                                          ICN::X_LOC1,
+                                          ICN::X_LOC2,
+                                          ICN::X_LOC3 };
+
+    bool isSpanDrawingIcnId( const int id )
+    {
+        return spanDrawingIcnId.count( id ) > 0;
+    }
+
+    bool _isPixelSpanDrawingEnabled{ true };
+
+    // Sprites of these ICNs are used only by the battle and castle screens, so no references to them are held outside of these screens.
+    // They can be evicted from the cache once a screen is closed and will be decoded again the next time they are needed.
+    bool isEvictableIcnId( const int id )
+    {
+        if ( id >= ICN::TWNBBOAT && id <= ICN::TWNZWELL ) {
+            // Castle buildings.
+            return true;
+        }
+
+        static const std::set<int> monsterIcnId = []() {
+            std::set<int> result;
+
+            for ( int monsterId = Monster::UNKNOWN + 1; monsterId < Monster::MONSTER_COUNT; ++monsterId ) {
+                const int icnId = fheroes2::getMonsterData( monsterId ).icnId;
+                if ( icnId != ICN::UNKNOWN ) {
+                    result.emplace( icnId );
+                }
+            }
+
+            return result;
+        }();
+
+        return monsterIcnId.count( id ) > 0;
+    }
+
+    size_t getSpriteMemoryUsage( const std::vector<fheroes2::Sprite> & sprites )
+    {
+        size_t usage = 0;
+
+        for ( const fheroes2::Sprite & sprite : sprites ) {
+            const size_t layerSize = static_cast<size_t>( sprite.width() ) * static_cast<size_t>( sprite.height() );
+            usage += sprite.singleLayer() ? layerSize : layerSize * 2;
+        }
+
+        return usage;
+    }
+
+    void registerLoadedICN( const int id )
+    {
+        ICNCacheInfo & info = _icnCacheInfo[id];
+
+        // The ICN could be cleared without eviction (for example, after a language change), so the previous usage must be replaced.
+        _icnCacheStatistics.memoryUsage -= info.memoryUsage;
+        info.memoryUsage = getSpriteMemoryUsage( _icnVsSprite[id] );
+        _icnCacheStatistics.memoryUsage += info.memoryUsage;
+    }
+
+    void evictICN( const int id )
+    {
+        ICNCacheInfo & info = _icnCacheInfo[id];
+
+        _icnVsSprite[id].clear();
+        _icnVsScaledSprite.erase( id );
+
+        _icnCacheStatistics.memoryUsage -= info.memoryUsage;
+        info.memoryUsage = 0;
+
+        ++_icnCacheStatistics.evictionCount;
+    }
+
     bool useOriginalResources()
     {
         const fheroes2::SupportedLanguage currentLanguage = fheroes2::getCurrentLanguage();
@@ -643,8 +795,8 @@ namespace
 
     void replacePOLAssetWithSW( const int id, const int assetIndex )
     {
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), true );
-        ROStreamBuf imageStream( body );
+        const fheroes2::AGGFileData body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), true );
+        ROStreamBuf imageStream( body.data(), body.size() );
 
         imageStream.seek( headerSize + assetIndex * 13 );
 
@@ -661,28 +813,25 @@ namespace
         _icnVsSprite[id][assetIndex] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
     }
 
-    // This function returns true if sprites were successfully loaded from AGG file.
-    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
-    bool readIcnFromAgg( const int id )
+    // Decodes all sprites of the given ICN from AGG file. Returns an empty vector if the ICN is not present in AGG file.
+    // This function does not access any cached resources, so it can be called from any thread.
+    std::vector<fheroes2::Sprite> decodeIcnSpritesFromAgg( const int id )
     {
-        // If this assertion blows up then something wrong with your logic and you load resources more than once!
-        assert( _icnVsSprite[id].empty() );
-
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+        const fheroes2::AGGFileData body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
 
         if ( body.empty() ) {
-            return false;
+            return {};
         }
 
-        ROStreamBuf imageStream( body );
+        ROStreamBuf imageStream( body.data(), body.size() );
 
         const uint32_t count = imageStream.getLE16();
         const uint32_t blockSize = imageStream.getLE32();
         if ( count == 0 || blockSize == 0 ) {
-            return false;
+            return {};
         }
 
-        _icnVsSprite[id].resize( count );
+        std::vector<fheroes2::Sprite> sprites( count );
 
         for ( uint32_t i = 0; i < count; ++i ) {
             imageStream.seek( headerSize + i * 13 );
@@ -713,9 +862,153 @@ namespace
             const uint8_t * data = body.data() + headerSize + header1.offsetData;
             const uint8_t * dataEnd = data + dataSize;
 
-            _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+            sprites[i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+        }
+
+        return sprites;
+    }
+
+    // Decoding of ICN sprites from AGG file is the most time consuming part of loading of big ICNs like battle monsters or castle buildings.
+    // It does not depend on any other resources, so it can be done in advance by a worker thread. All the post-processing is still done
+    // by the main thread when the ICN is requested for the first time.
+    class AsyncICNDecoder final : public MultiThreading::AsyncManager
+    {
+    public:
+        void push( const std::vector<int> & icnIds )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            for ( const int id : icnIds ) {
+                if ( _queuedIds.count( id ) > 0 || _decodedSprites.count( id ) > 0 || id == _currentId ) {
+                    continue;
+                }
+
+                _queue.push_back( id );
+                _queuedIds.insert( id );
+            }
+
+            notifyWorker();
         }
 
+        // Returns true and moves decoded sprites into the output if the ICN has been requested for decoding. If the ICN is being decoded
+        // at the moment then this function waits for its completion. If the decoding has not started yet then it is cancelled.
+        bool take( const int id, std::vector<fheroes2::Sprite> & output )
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            if ( _queuedIds.erase( id ) > 0 ) {
+                // It is faster to decode the ICN right away than to wait for the worker thread.
+                _queue.erase( std::find( _queue.begin(), _queue.end(), id ) );
+                return false;
+            }
+
+            _decodingCompletion.wait( lock, [this, id] { return _currentId != id; } );
+
+            auto iter = _decodedSprites.find( id );
+            if ( iter == _decodedSprites.end() ) {
+                return false;
+            }
+
+            const bool isDecoded = iter->second.has_value();
+            if ( isDecoded ) {
+                output = std::move( *iter->second );
+            }
+
+            _decodedSprites.erase( iter );
+
+            return isDecoded;
+        }
+
+        // Drops all pending tasks and all decoded sprites which have not been requested yet.
+        void clear()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _queue.clear();
+            _queuedIds.clear();
+            _decodedSprites.clear();
+        }
+
+    private:
+        std::deque<int> _queue;
+        std::set<int> _queuedIds;
+
+        // An empty value means that decoding failed and the ICN must be decoded by the main thread to report the error.
+        std::map<int, std::optional<std::vector<fheroes2::Sprite>>> _decodedSprites;
+
+        // The ICN being decoded at the moment. It is modified only by the worker thread while holding _mutex.
+        int _currentId{ ICN::UNKNOWN };
+
+        std::condition_variable _decodingCompletion;
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            if ( _queue.empty() ) {
+                _currentId = ICN::UNKNOWN;
+
+                return false;
+            }
+
+            _currentId = _queue.front();
+            _queue.pop_front();
+            _queuedIds.erase( _currentId );
+
+            return true;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            const int id = _currentId;
+            if ( id == ICN::UNKNOWN ) {
+                // Nothing to do.
+                return;
+            }
+
+            std::optional<std::vector<fheroes2::Sprite>> sprites;
+
+            try {
+                sprites = decodeIcnSpritesFromAgg( id );
+            }
+            catch ( const std::exception & ) {
+                // The error will be reported when this ICN is decoded by the main thread.
+                sprites.reset();
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _decodedSprites.emplace( id, std::move( sprites ) );
+                _currentId = ICN::UNKNOWN;
+            }
+
+            _decodingCompletion.notify_all();
+        }
+    };
+
+    AsyncICNDecoder asyncICNDecoder;
+
+    // This function returns true if sprites were successfully loaded from AGG file.
+    // WARNING: this function must be called once - only in the beginning of `decodeICN()` function.
+    bool readIcnFromAgg( const int id )
+    {
+        // If this assertion blows up then something wrong with your logic and you load resources more than once!
+        assert( _icnVsSprite[id].empty() );
+
+        std::vector<fheroes2::Sprite> sprites;
+        if ( !asyncICNDecoder.take( id, sprites ) ) {
+            sprites = decodeIcnSpritesFromAgg( id );
+        }
+
+        if ( sprites.empty() ) {
+            return false;
+        }
+
+        _icnVsSprite[id] = std::move( sprites );
+
         return true;
     }
 
@@ -2461,7 +2754,7 @@ namespace
     }
 
     //  This function modifies (fixes) the original ICNs and generate new fheroes2-related ICNs.
-    // WARNING: This function must be called only once from `loadICN()` function!
+    // WARNING: This function must be called only once from `decodeICN()` function!
     void processICN( const int id )
     {
         // If this assertion blows up then you are calling this function in a recursion. Check your code!
@@ -2485,7 +2778,7 @@ namespace
                 throw std::logic_error( "The game resources are corrupted. Please use resources from a licensed version of Heroes of Might and Magic II." );
             }
 
-            const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+            const fheroes2::AGGFileData body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
             const uint32_t crc32 = fheroes2::calculateCRC32( body.data(), body.size() );
 
             if ( id == ICN::SMALFONT ) {
@@ -4102,7 +4395,7 @@ namespace
                 }
                 digit += std::to_string( i + 1 );
 
-                _icnVsSprite[id][i] = fheroes2::decodeBMPFile( AGG::getDataFromAggFile( std::string( "ADVMBW" ) + digit + ".BMP", false ) );
+                _icnVsSprite[id][i] = fheroes2::decodeBMPFile( AGG::getDataFromAggFile( std::string( "ADVMBW" ) + digit + ".BMP", false ).toVector() );
             }
             break;
         }
@@ -4117,7 +4410,7 @@ namespace
                 }
                 digit += std::to_string( i );
 
-                _icnVsSprite[id][i] = fheroes2::decodeBMPFile( AGG::getDataFromAggFile( std::string( "SPELBW" ) + digit + ".BMP", false ) );
+                _icnVsSprite[id][i] = fheroes2::decodeBMPFile( AGG::getDataFromAggFile( std::string( "SPELBW" ) + digit + ".BMP", false ).toVector() );
             }
             break;
         }
@@ -4132,7 +4425,7 @@ namespace
                 }
                 digit += std::to_string( i + 1 );
 
-                _icnVsSprite[id][i] = fheroes2::decodeBMPFile( AGG::getDataFromAggFile( std::string( "CMSEBW" ) + digit + ".BMP", false ) );
+                _icnVsSprite[id][i] = fheroes2::decodeBMPFile( AGG::getDataFromAggFile( std::string( "CMSEBW" ) + digit + ".BMP", false ).toVector() );
             }
             break;
         }
@@ -5650,13 +5943,41 @@ namespace
         }
     }
 
+    void decodeICN( const int id );
+
     void loadICN( const int id )
     {
+        ICNCacheInfo & info = _icnCacheInfo[id];
+        info.lastAccess = ++_icnAccessCounter;
+
+        if ( !_icnLoadingStack.empty() ) {
+            info.isGenerationDependent = true;
+
+            for ( const int loadingId : _icnLoadingStack ) {
+                _icnCacheInfo[loadingId].isGenerationDependent = true;
+            }
+        }
+
         if ( !_icnVsSprite[id].empty() ) {
             // The images have been loaded.
+            ++_icnCacheStatistics.hitCount;
             return;
         }
 
+        ++_icnCacheStatistics.missCount;
+
+        _icnLoadingStack.push_back( id );
+
+        decodeICN( id );
+
+        assert( !_icnLoadingStack.empty() && _icnLoadingStack.back() == id );
+        _icnLoadingStack.pop_back();
+
+        registerLoadedICN( id );
+    }
+
+    void decodeICN( const int id )
+    {
         // Some images contain text. This text should be adapted to a chosen language.
         if ( isLanguageDependentIcnId( id ) ) {
             generateLanguageSpecificImages( id );
@@ -5680,6 +6001,13 @@ namespace
             // In order to avoid subsequent attempts to get resources from this ICN we are making it as non-empty.
             _icnVsSprite[id].resize( 1 );
         }
+
+        // Spans must be built after all modifications of the sprites, otherwise they will be dropped.
+        if ( _isPixelSpanDrawingEnabled && isSpanDrawingIcnId( id ) ) {
+            for ( fheroes2::Sprite & sprite : _icnVsSprite[id] ) {
+                sprite.buildSpans();
+            }
+        }
     }
 
     size_t GetMaximumICNIndex( int id )
@@ -5696,14 +6024,14 @@ namespace
         if ( tilImages.empty() ) {
             tilImages.resize( 4 ); // 4 possible sides
 
-            const std::vector<uint8_t> & data = ::AGG::getDataFromAggFile( tilFileName[id], false );
+            const fheroes2::AGGFileData data = ::AGG::getDataFromAggFile( tilFileName[id], false );
             if ( data.size() < headerSize ) {
                 // The important resource is absent! Make sure that you are using the correct version of the game.
                 assert( 0 );
                 return 0;
             }
 
-            ROStreamBuf buffer( data );
+            ROStreamBuf buffer( data.data(), data.size() );
 
             const size_t count = buffer.getLE16();
             const int32_t width = buffer.getLE16();
@@ -5886,4 +6214,81 @@ namespace fheroes2::AGG
         currentCodePage = getCodePage( language );
         areOriginalResourcesInUse = loadOriginalAlphabet;
     }
+
+    void setPixelSpanDrawing( const bool enable )
+    {
+        _isPixelSpanDrawingEnabled = enable;
+    }
+
+    void prefetchICN( const std::vector<int> & icnIds )
+    {
+        std::vector<int> idsToDecode;
+        idsToDecode.reserve( icnIds.size() );
+
+        for ( const int id : icnIds ) {
+            // Only ICNs which are read directly from AGG file can be decoded in advance.
+            if ( !IsValidICNId( id ) || id >= ICN::LAST_VALID_FILE_ICN || !_icnVsSprite[id].empty() || isLanguageDependentIcnId( id ) ) {
+                continue;
+            }
+
+            idsToDecode.push_back( id );
+        }
+
+        if ( !idsToDecode.empty() ) {
+            asyncICNDecoder.push( idsToDecode );
+        }
+    }
+
+    void stopICNPrefetching()
+    {
+        asyncICNDecoder.clear();
+        asyncICNDecoder.stopWorker();
+    }
+
+    ICNCacheStatistics getICNCacheStatistics()
+    {
+        return _icnCacheStatistics;
+    }
+
+    void setICNCacheMemoryLimit( const size_t limit )
+    {
+        _icnCacheMemoryLimit = limit;
+    }
+
+    void trimICNCache()
+    {
+        // ICNs are not evicted while some of them are being loaded since they might be in use by the loading code.
+        assert( _icnLoadingStack.empty() );
+
+        // Sprites decoded in advance for the screen which has just been closed are not going to be requested anymore.
+        asyncICNDecoder.clear();
+
+        if ( _icnCacheMemoryLimit == 0 || _icnCacheStatistics.memoryUsage <= _icnCacheMemoryLimit ) {
+            return;
+        }
+
+        std::vector<int> evictableIds;
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            if ( _icnCacheInfo[id].memoryUsage > 0 && !_icnCacheInfo[id].isGenerationDependent && isEvictableIcnId( id ) ) {
+                evictableIds.push_back( id );
+            }
+        }
+
+        std::sort( evictableIds.begin(), evictableIds.end(), []( const int first, const int second ) {
+            return _icnCacheInfo[first].lastAccess < _icnCacheInfo[second].lastAccess;
+        } );
+
+        for ( const int id : evictableIds ) {
+            if ( _icnCacheStatistics.memoryUsage <= _icnCacheMemoryLimit ) {
+                break;
+            }
+
+            evictICN( id );
+        }
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE,
+                   "ICN cache: " << _icnCacheStatistics.memoryUsage << " bytes used out of " << _icnCacheMemoryLimit << ", " << _icnCacheStatistics.hitCount
+                                 << " hits, " << _icnCacheStatistics.missCount << " misses, " << _icnCacheStatistics.evictionCount << " evictions" )
+    }
 }
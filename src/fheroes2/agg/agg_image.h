@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
@@ -37,7 +39,41 @@ namespace fheroes2
         // shapeId could be 0, 1, 2 or 3 only
         const Image & GetTIL( int tilId, uint32_t index, uint32_t shapeId );
 
+        // Requests the given ICNs to be decoded from AGG files by a worker thread, so that the first call of GetICN() for them does not
+        // need to do it. GetICN() waits for the completion if the decoding is still in progress at the time of the call.
+        void prefetchICN( const std::vector<int> & icnIds );
+
+        // Stops the worker thread used by prefetchICN(). Must be called before AGG files are closed.
+        void stopICNPrefetching();
+
         // This function must be called only at the time of setting up a new language.
         void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet );
+
+        // Enables or disables drawing of the Adventure Map sprites using pixel spans. It affects only the sprites loaded after this call,
+        // so it should be called before any of them are loaded. Spans are enabled by default.
+        void setPixelSpanDrawing( const bool enable );
+
+        struct ICNCacheStatistics
+        {
+            // Number of ICN accesses when sprites were already decoded.
+            uint64_t hitCount{ 0 };
+
+            // Number of ICN accesses which required decoding of sprites.
+            uint64_t missCount{ 0 };
+
+            uint64_t evictionCount{ 0 };
+
+            // Approximate amount of memory in bytes used by all decoded ICN sprites.
+            size_t memoryUsage{ 0 };
+        };
+
+        ICNCacheStatistics getICNCacheStatistics();
+
+        // Sets the memory budget in bytes for decoded ICN sprites. Zero means no limit.
+        void setICNCacheMemoryLimit( const size_t limit );
+
+        // Evicts the least recently used ICNs from the cache until the memory usage fits the budget. Only ICNs used exclusively by
+        // the battle and castle screens are evicted, so this function must be called only when none of these screens is open.
+        void trimICNCache();
     }
 }
@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -53,12 +54,15 @@ namespace
     public:
         Bin_Info::MonsterAnimInfo getAnimInfo( const int monsterID )
         {
+            // Battles can be simulated by AI in several threads at the same time
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
             auto mapIterator = _animMap.find( monsterID );
             if ( mapIterator != _animMap.end() ) {
                 return mapIterator->second;
             }
 
-            Bin_Info::MonsterAnimInfo info( monsterID, AGG::getDataFromAggFile( GetFilename( monsterID ), false ) );
+            Bin_Info::MonsterAnimInfo info( monsterID, AGG::getDataFromAggFile( GetFilename( monsterID ), false ).toVector() );
             if ( info.isValid() ) {
                 _animMap[monsterID] = info;
                 return info;
@@ -70,6 +74,8 @@ namespace
 
     private:
         std::map<int, Bin_Info::MonsterAnimInfo> _animMap;
+
+        std::mutex _mutex;
     };
 
     MonsterAnimCache _infoCache;
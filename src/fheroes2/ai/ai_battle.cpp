@@ -604,7 +604,8 @@ namespace
 
 AI::BattlePlanner & AI::BattlePlanner::Get()
 {
-    static BattlePlanner ai;
+    // Battles can be simulated by AI in several threads at the same time, each thread has its own battle planner
+    thread_local BattlePlanner ai;
     return ai;
 }
 
@@ -755,7 +756,8 @@ Battle::Actions AI::BattlePlanner::planUnitTurn( Battle::Arena & arena, const Ba
                     return true;
                 }
 
-                assert( heroes.size() == 1 && heroes.at( 0 ) == actualHero );
+                // The hero can be a copy of the kingdom's hero if this battle is a simulation
+                assert( heroes.size() == 1 && heroes.at( 0 )->GetID() == actualHero->GetID() );
 
                 // Otherwise, if this hero is the last one, and there are no castles in the kingdom, then it will be impossible to re-hire this hero
                 const VecCastles & castles = kingdom.GetCastles();
@@ -0,0 +1,190 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "ai_battle_estimator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "army.h"
+#include "army_troop.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "heroes.h"
+#include "logging.h"
+#include "maps_tiles.h"
+#include "rand.h"
+#include "thread.h"
+#include "timing.h"
+#include "world.h"
+
+namespace
+{
+    // The cost of a battle grows with the number of troops taking part in it, so fewer battles are simulated for bigger armies. The limits
+    // do not depend on the speed of the computer, so AI makes the same decisions for the same game on every machine.
+    const size_t simulatedTroopBudget = 40;
+    const size_t minSimulationCount = 4;
+    const size_t maxSimulationCount = 16;
+
+    // Battles which are not finished after this number of rounds are considered lost, since such a long battle is too costly anyway.
+    const uint32_t maxBattleRounds = 50;
+
+    size_t getSimulationCount( const Army & heroArmy, const Army & tileArmy )
+    {
+        const size_t troopCount = std::max<size_t>( heroArmy.GetOccupiedSlotCount() + tileArmy.GetOccupiedSlotCount(), 1 );
+
+        return std::clamp( simulatedTroopBudget / troopCount, minSimulationCount, maxSimulationCount );
+    }
+
+    void appendArmyToKey( std::vector<int32_t> & key, const Army & army )
+    {
+        for ( size_t i = 0; i < army.Size(); ++i ) {
+            const Troop * troop = army.GetTroop( i );
+            assert( troop != nullptr );
+
+            if ( troop->isValid() ) {
+                key.push_back( troop->GetID() );
+                key.push_back( static_cast<int32_t>( troop->GetCount() ) );
+            }
+            else {
+                key.push_back( 0 );
+                key.push_back( 0 );
+            }
+        }
+    }
+
+    std::vector<int32_t> getCacheKey( const Heroes & hero, const Army & tileArmy, const int32_t tileIndex )
+    {
+        std::vector<int32_t> key{ hero.GetID(),
+                                  static_cast<int32_t>( hero.GetExperience() ),
+                                  hero.GetAttack(),
+                                  hero.GetDefense(),
+                                  hero.GetPower(),
+                                  hero.GetKnowledge(),
+                                  static_cast<int32_t>( hero.GetSpellPoints() ),
+                                  hero.GetMorale(),
+                                  hero.GetLuck(),
+                                  hero.GetArmy().isSpreadFormation() ? 1 : 0,
+                                  tileIndex };
+
+        appendArmyToKey( key, hero.GetArmy() );
+        appendArmyToKey( key, tileArmy );
+
+        return key;
+    }
+
+    uint32_t getSimulationSeed( const int32_t tileIndex, const size_t simulationId )
+    {
+        uint32_t seed = world.GetMapSeed();
+
+        Rand::combineSeedWithValueHash( seed, tileIndex );
+        Rand::combineSeedWithValueHash( seed, simulationId );
+
+        return seed;
+    }
+
+    // Returns the share of the hero's army strength lost in the battle, from 0 to 1. A lost battle is always a loss of 100%.
+    double simulateBattle( const Heroes & hero, const Army & tileArmy, const int32_t tileIndex, const size_t simulationId )
+    {
+        // Battles change the state of the participants (spell points, hero modes, troops), so they are fought by copies
+        Heroes attackingHero;
+        hero.copyBattlePropertiesTo( attackingHero );
+
+        Army defendingArmy;
+        defendingArmy.Assign( tileArmy );
+        defendingArmy.SetColor( tileArmy.GetColor() );
+
+        Army & attackingArmy = attackingHero.GetArmy();
+
+        const double initialStrength = attackingArmy.GetStrength();
+        if ( initialStrength <= 0 ) {
+            return 1.0;
+        }
+
+        Rand::PCG32 randomGenerator( getSimulationSeed( tileIndex, simulationId ) );
+
+        Battle::Arena arena( attackingArmy, defendingArmy, tileIndex, false, randomGenerator );
+
+        while ( arena.BattleValid() && arena.GetTurnNumber() < maxBattleRounds ) {
+            arena.Turns();
+        }
+
+        if ( arena.BattleValid() || !arena.GetResult().isAttackerWin() ) {
+            return 1.0;
+        }
+
+        arena.getAttackingForce().syncOriginalArmy();
+
+        return std::clamp( 1.0 - attackingArmy.GetStrength() / initialStrength, 0.0, 1.0 );
+    }
+}
+
+std::optional<AI::BattleOutcomeEstimate> AI::BattleOutcomeEstimator::estimate( const Heroes & hero, const Maps::Tile & tile )
+{
+    const int32_t tileIndex = tile.GetIndex();
+
+    const Army tileArmy( tile );
+    if ( !tileArmy.isValid() ) {
+        return {};
+    }
+
+    const auto [iter, inserted] = _cache.try_emplace( getCacheKey( hero, tileArmy, tileIndex ) );
+    if ( !inserted ) {
+        return iter->second;
+    }
+
+#ifdef WITH_DEBUG
+    const fheroes2::Time timer;
+#endif
+
+    // Every simulation has its own slot for the result, so the estimate does not depend on the order in which simulations are performed
+    std::vector<double> losses( getSimulationCount( hero.GetArmy(), tileArmy ) );
+
+    MultiThreading::executeInParallel( losses.size(), [&hero, &tileArmy, tileIndex, &losses]( const size_t simulationId ) {
+        losses[simulationId] = simulateBattle( hero, tileArmy, tileIndex, simulationId );
+    } );
+
+    BattleOutcomeEstimate result;
+
+    for ( const double loss : losses ) {
+        ++result.battleCount;
+
+        if ( loss < 1.0 ) {
+            ++result.attackerWinCount;
+        }
+
+        ++result.attackerLossDistribution[static_cast<size_t>( std::lround( loss * 10 ) )];
+
+        result.averageAttackerLoss += loss;
+    }
+
+    result.averageAttackerLoss /= result.battleCount;
+
+    DEBUG_LOG( DBG_AI, DBG_TRACE,
+               hero.GetName() << " vs tile " << tileIndex << ": " << result.battleCount << " battles, win rate " << result.getAttackerWinRate() << ", average loss "
+                              << result.averageAttackerLoss << ", " << timer.getMs() << " ms" )
+
+    iter->second = result;
+
+    return result;
+}
@@ -0,0 +1,74 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+class Heroes;
+
+namespace Maps
+{
+    class Tile;
+}
+
+namespace AI
+{
+    struct BattleOutcomeEstimate
+    {
+        double getAttackerWinRate() const
+        {
+            return battleCount == 0 ? 0.0 : static_cast<double>( attackerWinCount ) / battleCount;
+        }
+
+        uint32_t battleCount{ 0 };
+        uint32_t attackerWinCount{ 0 };
+
+        // Number of battles by the share of the attacking army strength lost in the battle, in steps of 10%. Lost battles are counted as a loss of 100%.
+        std::array<uint32_t, 11> attackerLossDistribution{};
+
+        // Average share of the attacking army strength lost in the battle, from 0 to 1
+        double averageAttackerLoss{ 0 };
+    };
+
+    // Estimates the outcome of a battle between an AI hero and the army guarding a tile by simulating this battle several times with different
+    // random seeds. Simulations are performed in parallel on copies of the hero and the guarding army, so the game state is never changed.
+    // The number of simulations depends only on the size of the armies, so the estimate is the same on every computer.
+    class BattleOutcomeEstimator
+    {
+    public:
+        // Returns an empty result if the tile is not guarded. Results are cached by the composition of both armies (and the relevant hero
+        // properties), so the same battle is simulated at most once until the cache is cleared.
+        std::optional<BattleOutcomeEstimate> estimate( const Heroes & hero, const Maps::Tile & tile );
+
+        // The cache must be cleared at least once per turn since there are hero properties that affect battles but are not part of the cache key
+        void clearCache()
+        {
+            _cache.clear();
+        }
+
+    private:
+        std::map<std::vector<int32_t>, BattleOutcomeEstimate> _cache;
+    };
+}
@@ -20,21 +20,29 @@
 
 #include "ai_planner.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <utility>
 #include <vector>
 
+#include "ai_planner_internals.h"
 #include "army.h"
+#include "difficulty.h"
+#include "game.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "maps.h"
 #include "maps_tiles.h"
 #include "mp2.h"
 #include "profit.h"
 #include "resource.h"
 #include "route.h"
+#include "skill.h"
 #include "world.h"
 
 AI::Planner & AI::Planner::Get()
@@ -70,6 +78,94 @@ void AI::Planner::revealFog( const Maps::Tile & tile, const Kingdom & kingdom )
     }
 }
 
+AI::Planner::EnemyThreatField & AI::Planner::getEnemyThreatField( const EnemyArmy & enemyArmy )
+{
+    EnemyThreatField & field = _enemyThreatFields[enemyArmy.index];
+
+    const EnemyArmy & cachedArmy = field.enemyArmy;
+    if ( cachedArmy.index != enemyArmy.index || cachedArmy.hero != enemyArmy.hero || std::fabs( cachedArmy.strength - enemyArmy.strength ) > 0.001
+         || cachedArmy.movePoints != enemyArmy.movePoints ) {
+        field = {};
+        field.enemyArmy = enemyArmy;
+    }
+
+    return field;
+}
+
+const std::vector<uint32_t> & AI::Planner::getEnemyHeroThreatDistances( const EnemyArmy & enemyArmy )
+{
+    assert( enemyArmy.hero != nullptr );
+
+    EnemyThreatField & field = getEnemyThreatField( enemyArmy );
+    if ( !field.heroThreatDistances.empty() ) {
+        return field.heroThreatDistances;
+    }
+
+    _pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
+
+    field.heroThreatDistances.resize( world.getSize() );
+    for ( size_t i = 0; i < field.heroThreatDistances.size(); ++i ) {
+        field.heroThreatDistances[i] = _pathfinder.getDistance( static_cast<int32_t>( i ) );
+    }
+
+    return field.heroThreatDistances;
+}
+
+const std::vector<uint32_t> & AI::Planner::getEnemyArmyCastleThreatDistances( const EnemyArmy & enemyArmy, const PlayerColor color )
+{
+    EnemyThreatField & field = getEnemyThreatField( enemyArmy );
+    if ( !field.castleThreatDistances.empty() && field.castleThreatColor == color ) {
+        return field.castleThreatDistances;
+    }
+
+    _pathfinder.reEvaluateIfNeeded( enemyArmy.index, color, enemyArmy.strength, Skill::Level::EXPERT );
+
+    field.castleThreatDistances.resize( world.getSize() );
+    for ( size_t i = 0; i < field.castleThreatDistances.size(); ++i ) {
+        field.castleThreatDistances[i] = _pathfinder.getDistance( static_cast<int32_t>( i ) );
+    }
+
+    field.castleThreatColor = color;
+
+    return field.castleThreatDistances;
+}
+
+void AI::Planner::invalidateEnemyThreatFields( const int32_t tileIndex )
+{
+    if ( _isEnemyThreatFieldInvalidationSuspended || _enemyThreatFields.empty() ) {
+        return;
+    }
+
+    assert( Maps::isValidAbsIndex( tileIndex ) );
+
+    const Maps::Indexes aroundIndexes = Maps::getAroundIndexes( tileIndex );
+
+    // A tile can affect the distances only if it is reachable by the enemy army or is adjacent to a reachable tile.
+    const auto isWithinReach = [tileIndex, &aroundIndexes]( const std::vector<uint32_t> & distances, const int32_t startIndex ) {
+        if ( distances.empty() ) {
+            return false;
+        }
+
+        if ( tileIndex == startIndex || distances[tileIndex] > 0 ) {
+            return true;
+        }
+
+        return std::any_of( aroundIndexes.begin(), aroundIndexes.end(), [&distances, startIndex]( const int32_t index ) {
+            return index == startIndex || distances[index] > 0;
+        } );
+    };
+
+    for ( auto & [index, field] : _enemyThreatFields ) {
+        if ( isWithinReach( field.heroThreatDistances, index ) ) {
+            field.heroThreatDistances.clear();
+        }
+
+        if ( isWithinReach( field.castleThreatDistances, index ) ) {
+            field.castleThreatDistances.clear();
+        }
+    }
+}
+
 double AI::Planner::getTileArmyStrength( const Maps::Tile & tile )
 {
     const auto [iter, inserted] = _tileArmyStrengthValues.try_emplace( tile.GetIndex(), 0.0 );
@@ -84,6 +180,33 @@ double AI::Planner::getTileArmyStrength( const Maps::Tile & tile )
     return iter->second;
 }
 
+bool AI::Planner::isHeroStrongEnoughToAttack( const Heroes & hero, const Maps::Tile & tile, const double heroArmyStrength, const double targetStrengthMultiplier )
+{
+    const double tileArmyStrength = getTileArmyStrength( tile );
+    const bool isStronger = heroArmyStrength > tileArmyStrength * targetStrengthMultiplier;
+
+    if ( !Difficulty::isBattleSimulationAllowedForAI( Game::getDifficulty() ) ) {
+        return isStronger;
+    }
+
+    // The comparison of army strengths is reliable enough when one of the armies is clearly stronger, and battle simulations are expensive,
+    // so they are used only for close fights.
+    if ( heroArmyStrength > tileArmyStrength * targetStrengthMultiplier * ARMY_ADVANTAGE_SMALL || heroArmyStrength < tileArmyStrength * ARMY_ADVANTAGE_DESPERATE ) {
+        return isStronger;
+    }
+
+    const std::optional<BattleOutcomeEstimate> estimate = _battleOutcomeEstimator.estimate( hero, tile );
+    if ( !estimate ) {
+        return isStronger;
+    }
+
+    // A hero who is about to lose the game has nothing to lose, so he can take more risks
+    const double minWinRate = hero.isLosingGame() ? 0.75 : 0.9;
+    const double maxAverageLoss = hero.isLosingGame() ? 0.5 : 0.3;
+
+    return estimate->getAttackerWinRate() >= minWinRate && estimate->averageAttackerLoss <= maxAverageLoss;
+}
+
 double AI::Planner::getResourcePriorityModifier( const int resource, const bool isMine ) const
 {
     // Not all resources are equally valuable: 1 gold does not have the same value as 1 gemstone, so we need to
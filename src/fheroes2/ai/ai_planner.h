@@ -23,11 +23,13 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "ai_battle_estimator.h"
 #include "resource.h"
 #include "world_pathfinding.h"
 
@@ -176,6 +178,22 @@ namespace AI
         void resetPathfinder()
         {
             _pathfinder.reset();
+            _enemyThreatFields.clear();
+
+            for ( auto & [dummy, pathfinder] : _heroPathfinders ) {
+                pathfinder.reset();
+            }
+        }
+
+        void markPathfinderTileChanged( const int32_t tileIndex )
+        {
+            _pathfinder.markTileChanged( tileIndex );
+
+            for ( auto & [dummy, pathfinder] : _heroPathfinders ) {
+                pathfinder.markTileChanged( tileIndex );
+            }
+
+            invalidateEnemyThreatFields( tileIndex );
         }
 
         void revealFog( const Maps::Tile & tile, const Kingdom & kingdom );
@@ -192,6 +210,10 @@ namespace AI
         // Army::setFromTile(), so this method is not suitable for hero armies or castle garrisons.
         double getTileArmyStrength( const Maps::Tile & tile );
 
+        // Returns true if the given hero should attack the army guarding the given tile. Obvious cases are resolved by comparing the army
+        // strengths, close fights are resolved (if allowed by the difficulty level) using the simulations of the battle.
+        bool isHeroStrongEnoughToAttack( const Heroes & hero, const Maps::Tile & tile, const double heroArmyStrength, const double targetStrengthMultiplier );
+
         static void HeroesPreBattle( HeroBase & hero, bool isAttacking );
         static void CastlePreBattle( Castle & castle );
 
@@ -217,6 +239,12 @@ namespace AI
 
         int getPriorityTarget( Heroes & hero, double & maxPriority );
 
+        // Evaluates the pathfinders of the given heroes in parallel, using the current settings of the main pathfinder
+        void prepareHeroPathfinders( const std::vector<Heroes *> & heroes );
+
+        // If the pathfinder for the given hero has been prepared in advance, then the main pathfinder takes over its cache
+        void usePreparedHeroPathfinder( const Heroes & hero );
+
         double getGeneralObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getFighterObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getCourierObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
@@ -244,6 +272,33 @@ namespace AI
         // IMPORTANT!!! Do not call this method directly. Use other methods which call it internally.
         bool updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy );
 
+        struct EnemyThreatField
+        {
+            // The state of the enemy army at the time of calculation of the distances.
+            EnemyArmy enemyArmy;
+
+            // Distances from the point of view of the enemy hero, used to estimate threats for our heroes.
+            std::vector<uint32_t> heroThreatDistances;
+
+            // Distances from the point of view of the kingdom of the castleThreatColor color, used to estimate threats for its castles.
+            std::vector<uint32_t> castleThreatDistances;
+            PlayerColor castleThreatColor{ PlayerColor::NONE };
+        };
+
+        // Returns the cached distances of the enemy army. They are discarded if the enemy army has changed since their calculation.
+        EnemyThreatField & getEnemyThreatField( const EnemyArmy & enemyArmy );
+
+        // Returns the distances from the enemy hero to all tiles of the map from the point of view of this hero. The pathfinder must be configured
+        // with the "optimistic" settings for enemy armies.
+        const std::vector<uint32_t> & getEnemyHeroThreatDistances( const EnemyArmy & enemyArmy );
+
+        // Returns the distances from the enemy army to all tiles of the map from the point of view of the kingdom of the given color. The pathfinder
+        // must be configured with the "optimistic" settings for enemy armies and the heroes of the kingdom must be temporarily removed from the map.
+        const std::vector<uint32_t> & getEnemyArmyCastleThreatDistances( const EnemyArmy & enemyArmy, const PlayerColor color );
+
+        // Discards the distances of enemy armies which could be affected by the change of the given tile.
+        void invalidateEnemyThreatFields( const int32_t tileIndex );
+
         void removePriorityAttackTarget( const int32_t tileIndex );
         void updatePriorityAttackTarget( const Kingdom & kingdom, const Maps::Tile & tile );
 
@@ -273,10 +328,24 @@ namespace AI
         // It is important to update this cache after performing an action on the corresponding tile.
         std::unordered_map<int32_t, double> _tileArmyStrengthValues;
 
+        // Distances from enemy armies to the tiles of the map, by the enemy army tile index. Their calculation is a heavy operation, so they are
+        // calculated on demand and shared by all heroes and castles of the kingdom during its turn. The distances are discarded when the enemy army
+        // changes or when a tile within its reach changes.
+        std::unordered_map<int32_t, EnemyThreatField> _enemyThreatFields;
+
+        // Heroes are temporarily removed from the map to estimate threats for castles. This should not discard any distances.
+        bool _isEnemyThreatFieldInvalidationSuspended{ false };
+
+        // Estimates of close fights with the armies guarding the tiles. This cache is cleared every turn as well.
+        BattleOutcomeEstimator _battleOutcomeEstimator;
+
         std::vector<RegionStats> _regions;
 
         std::array<BudgetEntry, 7> _budget = { Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
 
         AIWorldPathfinder _pathfinder;
+
+        // Pathfinders that are evaluated in advance (and in parallel) for the heroes of the current kingdom, by hero ID
+        std::map<int32_t, AIWorldPathfinder> _heroPathfinders;
     };
 }
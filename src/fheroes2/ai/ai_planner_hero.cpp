@@ -74,6 +74,7 @@
 #include "settings.h"
 #include "skill.h"
 #include "spell.h"
+#include "thread.h"
 #include "visit.h"
 #include "world.h"
 #include "world_pathfinding.h"
@@ -690,7 +691,7 @@ namespace
             break;
 
         case MP2::OBJ_MONSTER:
-            return isHeroStrongerThan( tile, ai, heroArmyStrength, ( hero.isLosingGame() ? 1.0 : AI::ARMY_ADVANTAGE_MEDIUM ) );
+            return ai.isHeroStrongEnoughToAttack( hero, tile, heroArmyStrength, ( hero.isLosingGame() ? 1.0 : AI::ARMY_ADVANTAGE_MEDIUM ) );
 
         case MP2::OBJ_HERO: {
             const Heroes * otherHero = tile.getHero();
@@ -2433,16 +2434,15 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), enemyArmy.index ) * Maps::Ground::fastestMovePenalty
                                             > hero.GetMovePoints() + enemyArmyMovePointsThreshold );
 
-            if ( !useRoughEstimate ) {
-                // Pre-cache the pathfinder database for the enemy hero
-                _pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
-            }
+            // Distances used for an accurate estimate are shared by all heroes of the kingdom
+            const std::vector<uint32_t> * enemyHeroDistances = useRoughEstimate ? nullptr : &getEnemyHeroThreatDistances( enemyArmy );
 
             for ( size_t i = 0; i < result.size(); ++i ) {
                 const int32_t tileIdx = static_cast<int32_t>( i );
                 assert( Maps::isValidAbsIndex( tileIdx ) );
 
-                const auto [distToTile, isTileConsideredSafe] = [this, enemyArmyIdx = enemyArmy.index, enemyArmyMovePointsThreshold, useRoughEstimate, tileIdx]() {
+                const auto [distToTile, isTileConsideredSafe] = [enemyHeroDistances, enemyArmyIdx = enemyArmy.index, enemyArmyMovePointsThreshold, useRoughEstimate,
+                                                                 tileIdx]() {
                     // The tile on which the enemy hero is located is always considered unsafe
                     if ( tileIdx == enemyArmyIdx ) {
                         return std::make_pair( static_cast<uint32_t>( 0 ), false );
@@ -2457,7 +2457,9 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
                         return std::make_pair( dist, dist > enemyArmyMovePointsThreshold );
                     }
 
-                    const uint32_t dist = _pathfinder.getDistance( tileIdx );
+                    assert( enemyHeroDistances != nullptr && static_cast<size_t>( tileIdx ) < enemyHeroDistances->size() );
+
+                    const uint32_t dist = ( *enemyHeroDistances )[tileIdx];
 
                     // When using an accurate estimate, a tile is considered safe if the enemy hero does not have access to it (in particular, if it is hidden from
                     // him in the fog) or he cannot reach it within one turn. The potential ability of the enemy hero to use spells to move to this tile (for example,
@@ -2479,6 +2481,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     }();
 
     // Pre-cache the pathfinder database for our hero
+    usePreparedHeroPathfinder( hero );
     _pathfinder.reEvaluateIfNeeded( hero );
 
     ObjectValidator objectValidator( hero, _pathfinder, *this );
@@ -3019,6 +3022,64 @@ void AI::Planner::HeroesPreBattle( HeroBase & hero, bool isAttacking )
     }
 }
 
+void AI::Planner::prepareHeroPathfinders( const std::vector<Heroes *> & heroes )
+{
+    // Keep the pathfinders only for the given heroes, they will most likely need only minor updates
+    for ( auto iter = _heroPathfinders.begin(); iter != _heroPathfinders.end(); ) {
+        if ( std::none_of( heroes.begin(), heroes.end(), [heroId = iter->first]( const Heroes * hero ) { return hero->GetID() == heroId; } ) ) {
+            iter = _heroPathfinders.erase( iter );
+        }
+        else {
+            ++iter;
+        }
+    }
+
+    std::vector<std::pair<const Heroes *, AIWorldPathfinder *>> pathfinders;
+    pathfinders.reserve( heroes.size() );
+
+    for ( const Heroes * hero : heroes ) {
+        assert( hero != nullptr );
+
+        const auto [iter, inserted] = _heroPathfinders.try_emplace( hero->GetID() );
+
+        AIWorldPathfinder & pathfinder = iter->second;
+        if ( inserted ) {
+            pathfinder.reset();
+        }
+
+        pathfinder.setMinimalArmyStrengthAdvantage( _pathfinder.getMinimalArmyStrengthAdvantage() );
+        pathfinder.setSpellPointsReserveRatio( _pathfinder.getSpellPointsReserveRatio() );
+
+        pathfinders.emplace_back( hero, &pathfinder );
+    }
+
+    // Each pathfinder only reads the state of the world, so the results do not depend on the order in which they are evaluated
+    MultiThreading::executeInParallel( pathfinders.size(), [&pathfinders]( const size_t i ) {
+        const auto & [hero, pathfinder] = pathfinders[i];
+
+        pathfinder->reEvaluateIfNeeded( *hero );
+    } );
+}
+
+void AI::Planner::usePreparedHeroPathfinder( const Heroes & hero )
+{
+    const auto iter = _heroPathfinders.find( hero.GetID() );
+    if ( iter == _heroPathfinders.end() ) {
+        return;
+    }
+
+    AIWorldPathfinder & pathfinder = iter->second;
+
+    // This pathfinder was prepared using different settings
+    if ( std::fabs( pathfinder.getMinimalArmyStrengthAdvantage() - _pathfinder.getMinimalArmyStrengthAdvantage() ) > 0.001
+         || std::fabs( pathfinder.getSpellPointsReserveRatio() - _pathfinder.getSpellPointsReserveRatio() ) > 0.001 ) {
+        return;
+    }
+
+    // The previous state of the main pathfinder is kept by the hero pathfinder, which will be re-evaluated if necessary
+    _pathfinder.swap( pathfinder );
+}
+
 fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & currentProgressValue, uint32_t endProgressValue, bool & moreTasksAvailable )
 {
     // By default there are always more tasks for heroes.
@@ -3070,6 +3131,8 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
                 _pathfinder.setMinimalArmyStrengthAdvantage( minStrengthAdvantage );
                 _pathfinder.setSpellPointsReserveRatio( spReserveRatio );
 
+                prepareHeroPathfinders( availableHeroes );
+
                 double maxPriority = 0;
 
                 for ( Heroes * hero : availableHeroes ) {
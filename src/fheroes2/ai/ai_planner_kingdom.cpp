@@ -91,8 +91,13 @@ namespace
 
         TemporaryHeroEraser( TemporaryHeroEraser && ) = delete;
 
-        explicit TemporaryHeroEraser( const std::vector<Heroes *> & heroes )
+        // The given flag is set for the lifetime of this object, so that the temporary changes of the map can be ignored by the caches.
+        TemporaryHeroEraser( const std::vector<Heroes *> & heroes, bool & isMapChangedTemporarily )
+            : _isMapChangedTemporarily( isMapChangedTemporarily )
         {
+            assert( !_isMapChangedTemporarily );
+            _isMapChangedTemporarily = true;
+
             for ( Heroes * hero : heroes ) {
                 assert( hero != nullptr && hero->isActive() );
 
@@ -117,6 +122,8 @@ namespace
 
                 tile.setHero( hero );
             }
+
+            _isMapChangedTemporarily = false;
         }
 
         TemporaryHeroEraser & operator=( const TemporaryHeroEraser & ) = delete;
@@ -125,6 +132,7 @@ namespace
 
     private:
         std::vector<Heroes *> _heroes;
+        bool & _isMapChangedTemporarily;
     };
 
     void setHeroRoles( VecHeroes & heroes, const int difficulty )
@@ -434,7 +442,7 @@ std::set<int> AI::Planner::findCastlesInDanger( const Kingdom & kingdom )
 
     // Since we are estimating danger for a castle and we need to know if an enemy hero can reach it
     // if no our heroes exist. So we are temporary removing them from the map.
-    const TemporaryHeroEraser heroEraser( kingdom.GetHeroes() );
+    const TemporaryHeroEraser heroEraser( kingdom.GetHeroes(), _isEnemyThreatFieldInvalidationSuspended );
 
     const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
@@ -463,7 +471,7 @@ void AI::Planner::updatePriorityForEnemyArmy( const Kingdom & kingdom, const Ene
 {
     // Since we are estimating danger for a castle and we need to know if an enemy hero can reach it
     // if no our heroes exist. So we are temporary removing them from the map.
-    const TemporaryHeroEraser heroEraser( kingdom.GetHeroes() );
+    const TemporaryHeroEraser heroEraser( kingdom.GetHeroes(), _isEnemyThreatFieldInvalidationSuspended );
 
     const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
@@ -486,7 +494,7 @@ void AI::Planner::updatePriorityForCastle( const Castle & castle )
 {
     // Since we are estimating danger for a castle and we need to know if an enemy hero can reach it
     // if no our heroes exist. So we are temporary removing them from the map.
-    const TemporaryHeroEraser heroEraser( castle.GetKingdom().GetHeroes() );
+    const TemporaryHeroEraser heroEraser( castle.GetKingdom().GetHeroes(), _isEnemyThreatFieldInvalidationSuspended );
 
     const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
@@ -517,7 +525,7 @@ bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, cons
     //
     // Of course, on the other hand, it may be the other way around - the enemy army may have access to some path that is not yet visible to the castle owner,
     // but since the castle owner doesn't know about this for sure, using this option smacks of cheating.
-    const uint32_t dist = _pathfinder.getDistance( enemyArmy.index, castleIndex, castle.GetColor(), enemyArmy.strength );
+    const uint32_t dist = getEnemyArmyCastleThreatDistances( enemyArmy, castle.GetColor() )[castleIndex];
     if ( dist == 0 || dist >= threatDistanceLimit ) {
         return false;
     }
@@ -654,9 +662,11 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     _mapActionObjects.clear();
     _priorityTargets.clear();
     _enemyArmies.clear();
+    _enemyThreatFields.clear();
 
     // Clear the tile army strength cache because the strength of the respective armies might have changed since last time
     _tileArmyStrengthValues.clear();
+    _battleOutcomeEstimator.clearCache();
 
     _regions.clear();
     _regions.resize( world.getRegionCount() );
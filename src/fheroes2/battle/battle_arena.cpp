@@ -70,7 +70,8 @@
 
 namespace
 {
-    Battle::Arena * arena = nullptr;
+    // Battles can be simulated by AI in several threads at the same time, each thread has its own current arena
+    thread_local Battle::Arena * arena = nullptr;
 
     template <typename T>
     Battle::Unit * getLastResurrectableUnitFromGraveyardTmpl( const Battle::Graveyard & graveyard, const HeroBase * commander, const int32_t index, const T & spells )
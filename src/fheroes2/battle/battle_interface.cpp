@@ -1450,6 +1450,17 @@ Battle::Interface::Interface( Arena & battleArena, const int32_t tileIndex )
         break;
     }
 
+    // Decode sprites of the battlefield and of all troops by a worker thread while the rest of the battle screen is being prepared.
+    std::vector<int> prefetchIcnIds{ _battleGroundIcn, _borderObjectsIcn };
+
+    for ( const Force * force : { &arena.getAttackingForce(), &arena.getDefendingForce() } ) {
+        for ( const Unit * unit : *force ) {
+            prefetchIcnIds.push_back( fheroes2::getMonsterData( unit->GetID() ).icnId );
+        }
+    }
+
+    fheroes2::AGG::prefetchICN( prefetchIcnIds );
+
     // Setup delay types for all common battlefield animations rendering.
     _commonAnimationsDelays = { Game::DelayType::BATTLE_FLAGS_DELAY, Game::DelayType::BATTLE_OPPONENTS_DELAY, Game::DelayType::BATTLE_SELECTED_UNIT_DELAY,
                                 Game::DelayType::BATTLE_IDLE_DELAY };
@@ -2886,7 +2897,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg, const bool high
         const auto formatViewInfoMsg = []( const Unit * unit ) {
             assert( unit != nullptr );
 
-            std::string msg = _( "View %{monster} info" );
+            std::string msg = _h( "View %{monster} info" );
             StringReplaceWithLowercase( msg, "%{monster}", unit->GetMultiName() );
 
             return msg;
@@ -2911,7 +2922,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg, const bool high
                     return Cursor::WAR_INFO;
                 }
 
-                statusMsg = _currentUnit->isFlying() ? _( "Fly %{monster} here" ) : _( "Move %{monster} here" );
+                statusMsg = _currentUnit->isFlying() ? _h( "Fly %{monster} here" ) : _h( "Move %{monster} here" );
                 StringReplaceWithLowercase( statusMsg, "%{monster}", _currentUnit->GetName() );
 
                 return _currentUnit->isFlying() ? Cursor::WAR_FLY : Cursor::WAR_MOVE;
@@ -2925,7 +2936,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg, const bool high
             }
 
             if ( _currentUnit->isArchers() && !_currentUnit->isHandFighting() ) {
-                statusMsg = _( "Shoot %{monster}" );
+                statusMsg = _h( "Shoot %{monster}" );
                 statusMsg.append( " " );
                 statusMsg.append( _n( "(1 shot left)", "(%{count} shots left)", _currentUnit->GetShots() ) );
                 StringReplaceWithLowercase( statusMsg, "%{monster}", unit->GetMultiName() );
@@ -3006,7 +3017,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg, const bool high
 
                 const int cursor = getSwordCursorForAttackDirection( currentDirection );
 
-                statusMsg = _( "Attack %{monster}" );
+                statusMsg = _h( "Attack %{monster}" );
                 StringReplaceWithLowercase( statusMsg, "%{monster}", unit->GetName() );
 
                 return cursor;
@@ -3014,7 +3025,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg, const bool high
         }
     }
 
-    statusMsg = _( "Turn %{turn}" );
+    statusMsg = _h( "Turn %{turn}" );
     StringReplace( statusMsg, "%{turn}", arena.GetTurnNumber() );
 
     return Cursor::WAR_NONE;
@@ -3042,18 +3053,18 @@ int Battle::Interface::GetBattleSpellCursor( std::string & statusMsg ) const
             assert( unitToTeleport != nullptr );
 
             if ( unitOnCell == nullptr && cell->isPassableForUnit( *unitToTeleport ) ) {
-                statusMsg = _( "Teleport here" );
+                statusMsg = _h( "Teleport here" );
 
                 return Cursor::SP_TELEPORT;
             }
 
-            statusMsg = _( "Invalid teleport destination" );
+            statusMsg = _h( "Invalid teleport destination" );
 
             return Cursor::WAR_NONE;
         }
 
         if ( unitOnCell && unitOnCell->AllowApplySpell( spell, _currentUnit->GetCurrentOrArmyCommander() ) ) {
-            statusMsg = _( "Cast %{spell} on %{monster}" );
+            statusMsg = _h( "Cast %{spell} on %{monster}" );
             StringReplace( statusMsg, "%{spell}", spell.GetName() );
             StringReplaceWithLowercase( statusMsg, "%{monster}", unitOnCell->GetName() );
 
@@ -3061,14 +3072,14 @@ int Battle::Interface::GetBattleSpellCursor( std::string & statusMsg ) const
         }
 
         if ( !spell.isApplyToFriends() && !spell.isApplyToEnemies() && !spell.isApplyToAnyTroops() ) {
-            statusMsg = _( "Cast %{spell}" );
+            statusMsg = _h( "Cast %{spell}" );
             StringReplace( statusMsg, "%{spell}", spell.GetName() );
 
             return getCursorForSpell( spell.GetID() );
         }
     }
 
-    statusMsg = _( "Select spell target" );
+    statusMsg = _h( "Select spell target" );
 
     return Cursor::WAR_NONE;
 }
@@ -31,6 +31,7 @@
 #include <utility>
 #include <vector>
 
+#include "agg_image.h"
 #include "ai_planner.h"
 #include "army.h"
 #include "army_troop.h"
@@ -473,6 +474,11 @@ Battle::Result Battle::Loader( Army & attackingArmy, Army & defendingArmy, const
         break;
     }
 
+    if ( showBattle ) {
+        // The battle screen is closed so none of the battle sprites are in use anymore.
+        fheroes2::AGG::trimICNCache();
+    }
+
     DEBUG_LOG( DBG_BATTLE, DBG_INFO, "attacking army: " << attackingArmy.String() )
     DEBUG_LOG( DBG_BATTLE, DBG_INFO, "defending army: " << defendingArmy.String() )
 
@@ -25,7 +25,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -42,6 +41,20 @@ namespace
 
 namespace Battle
 {
+    size_t BattlePathfinder::getCacheIndex( const BattleNodeIndex & index )
+    {
+        const auto [headCellIdx, tailCellIdx] = index;
+        assert( Board::isValidIndex( headCellIdx ) );
+
+        if ( tailCellIdx == -1 ) {
+            return static_cast<size_t>( headCellIdx ) * nodesPerCell;
+        }
+
+        assert( tailCellIdx == headCellIdx - 1 || tailCellIdx == headCellIdx + 1 );
+
+        return static_cast<size_t>( headCellIdx ) * nodesPerCell + ( tailCellIdx < headCellIdx ? 1 : 2 );
+    }
+
     void BattlePathfinder::reEvaluateIfNeeded( const Unit & unit )
     {
         assert( unit.GetHeadIndex() != -1 && ( unit.isWide() ? unit.GetTailIndex() != -1 : unit.GetTailIndex() == -1 ) );
@@ -73,8 +86,7 @@ namespace Battle
         const Castle * castle = Arena::GetCastle();
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
-        _cache.clear();
-        _cache.try_emplace( _pathStart );
+        _cache.fill( {} );
 
         // Flying units can land wherever they can fit
         if ( _isFlying ) {
@@ -90,12 +102,12 @@ namespace Battle
                 const int32_t headCellIdx = pos.GetHead()->GetIndex();
                 const int32_t tailCellIdx = pos.GetTail() ? pos.GetTail()->GetIndex() : -1;
 
-                if ( const auto [iter, inserted] = _cache.try_emplace( { headCellIdx, tailCellIdx } ); inserted ) {
+                if ( const BattleNodeIndex nodeIdx{ headCellIdx, tailCellIdx }; !isNodeReached( nodeIdx ) ) {
                     // Wide units can occupy overlapping positions, the distance between which is actually zero,
                     // but since the movement takes place, we will consider the distance equal to 1 in this case
                     const uint32_t distance = std::max<uint32_t>( Board::GetDistance( unit.GetPosition(), pos ), 1U );
 
-                    iter->second.update( _pathStart, 1, distance );
+                    _cache[getCacheIndex( nodeIdx )].update( _pathStart, 1, distance );
                 }
             }
 
@@ -132,7 +144,7 @@ namespace Battle
 
         for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < nodesToExplore.size(); ++nodesToExploreIdx ) {
             const BattleNodeIndex currentNodeIdx = nodesToExplore[nodesToExploreIdx];
-            const BattleNode & currentNode = _cache[currentNodeIdx];
+            const BattleNode & currentNode = _cache[getCacheIndex( currentNodeIdx )];
 
             if ( _isWide ) {
                 assert( currentNodeIdx.first != -1 && currentNodeIdx.second != -1 );
@@ -169,7 +181,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : movementPenalty );
                     const uint32_t distance = currentNode._distance + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : 1 );
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = _cache[getCacheIndex( newNodeIdx )];
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -206,7 +218,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + movementPenalty;
                     const uint32_t distance = currentNode._distance + 1;
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = _cache[getCacheIndex( newNodeIdx )];
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -228,14 +240,11 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        if ( !isNodeReached( nodeIdx ) ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
-
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return !isOnCurrentTurn || _cache[getCacheIndex( nodeIdx )]._cost <= _speed;
     }
 
     uint32_t BattlePathfinder::getCost( const Unit & unit, const Position & position )
@@ -246,14 +255,9 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
-
-        const auto & [index, node] = *iter;
-        // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( isNodeReached( nodeIdx ) );
 
-        return node._cost;
+        return _cache[getCacheIndex( nodeIdx )]._cost;
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
@@ -264,37 +268,33 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        assert( isNodeReached( nodeIdx ) );
 
-        const auto & [index, node] = *iter;
-        // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
-
-        return node._distance;
+        return _cache[getCacheIndex( nodeIdx )]._distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
     {
         reEvaluateIfNeeded( unit );
 
-        std::set<int32_t> boardIndexes;
+        Indexes result;
+        result.reserve( Board::sizeInCells );
 
-        for ( const auto & [index, node] : _cache ) {
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
+        // Nodes are ordered by the index of the head cell, so the resulting indexes are sorted and only adjacent duplicates are possible
+        for ( size_t cacheIdx = 0; cacheIdx < _cache.size(); ++cacheIdx ) {
+            const BattleNode & node = _cache[cacheIdx];
+            if ( node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
                 continue;
             }
 
-            assert( index.first != -1 );
+            // The starting node is never updated, so it is skipped as well
+            const int32_t headCellIdx = static_cast<int32_t>( cacheIdx / nodesPerCell );
 
-            boardIndexes.insert( index.first );
+            if ( result.empty() || result.back() != headCellIdx ) {
+                result.push_back( headCellIdx );
+            }
         }
 
-        Indexes result;
-
-        result.reserve( boardIndexes.size() );
-        result.assign( boardIndexes.begin(), boardIndexes.end() );
-
         return result;
     }
 
@@ -310,15 +310,10 @@ namespace Battle
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
-
-            if ( index == _pathStart ) {
-                break;
-            }
-
-            // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+        // Unreachable positions have no path
+        while ( nodeIdx != _pathStart && isNodeReached( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
+            const BattleNode & node = _cache[getCacheIndex( index )];
 
             nodeIdx = node._from;
 
@@ -365,15 +360,10 @@ namespace Battle
 
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
-
-            if ( index == _pathStart ) {
-                break;
-            }
-
-            // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+        // Unreachable positions have no path
+        while ( nodeIdx != _pathStart && isNodeReached( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
+            const BattleNode & node = _cache[getCacheIndex( index )];
 
             nodeIdx = node._from;
 
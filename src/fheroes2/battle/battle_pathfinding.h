@@ -23,7 +23,6 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
 
 #include "battle_board.h"
@@ -34,21 +33,9 @@ namespace Battle
     class Position;
     class Unit;
 
+    // Indexes of the cells occupied by the head and by the tail of the unit (-1 if the unit is not wide)
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from{ -1, -1 };
@@ -109,7 +96,20 @@ namespace Battle
         // Rebuilds the graph of available positions for the given unit if necessary (if it is not already cached)
         void reEvaluateIfNeeded( const Unit & unit );
 
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
+        // Returns true if the given node has been reached during the last evaluation (the starting node is always reached)
+        bool isNodeReached( const BattleNodeIndex & index ) const
+        {
+            return index == _pathStart || _cache[getCacheIndex( index )]._from != BattleNodeIndex{ -1, -1 };
+        }
+
+        // The tail of a wide unit is always either to the left or to the right of its head, so there are three possible
+        // nodes for each cell of the board: without a tail, with a tail on the left, and with a tail on the right
+        static constexpr size_t nodesPerCell = 3;
+
+        static size_t getCacheIndex( const BattleNodeIndex & index );
+
+        // The number of nodes is small and fixed, so they are stored in a flat array indexed by getCacheIndex()
+        std::array<BattleNode, Board::sizeInCells * nodesPerCell> _cache{};
 
         // Parameters of the unit for which the current cache is created
         BattleNodeIndex _pathStart{ -1, -1 };
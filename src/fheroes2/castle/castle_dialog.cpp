@@ -57,6 +57,7 @@
 #include "monster.h"
 #include "mus.h"
 #include "screen.h"
+#include "settings.h"
 #include "statusbar.h"
 #include "tools.h"
 #include "translations.h"
@@ -244,6 +245,21 @@ Castle::CastleDialogReturnValue Castle::OpenDialog( const bool openConstructionW
         restorer = std::make_unique<fheroes2::ImageRestorer>( display, dialogRoi.x, dialogRoi.y, dialogRoi.width, dialogRoi.height );
     }
 
+    // Decode sprites of the built buildings by a worker thread while the previous screen is fading out.
+    std::vector<int> prefetchIcnIds;
+
+    for ( const BuildingType buildingId : fheroes2::getBuildingDrawingPriorities( _race, Settings::Get().getCurrentMapInfo().version ) ) {
+        if ( isBuild( buildingId ) ) {
+            prefetchIcnIds.push_back( GetICNBuilding( buildingId, _race ) );
+        }
+    }
+
+    if ( HasBoatNearby() ) {
+        prefetchIcnIds.push_back( GetICNBoat( _race ) );
+    }
+
+    fheroes2::AGG::prefetchICN( prefetchIcnIds );
+
     // Fade-out game screen only for 640x480 resolution and if 'renderBackgroundDialog' is false (we are replacing image in already opened dialog).
     const bool isDefaultScreenSize = display.isDefaultSize();
     if ( fade && ( isDefaultScreenSize || !renderBackgroundDialog ) ) {
@@ -1582,7 +1582,7 @@ namespace Interface
                 else if ( HotKeyPressEvent( Game::HotKeyEvent::EDITOR_RANDOM_MAP_REGENERATE ) ) {
                     fheroes2::ActionCreator action( _historyManager, _mapFormat );
 
-                    if ( Maps::Random_Generator::generateMap( _mapFormat, _randomMapConfig, _mapFormat.width, _mapFormat.width ) ) {
+                    if ( generateRandomMap( _mapFormat.width ) ) {
                         _redraw |= mapUpdateFlags;
 
                         action.commit();
@@ -3099,6 +3099,11 @@ namespace Interface
 
     bool EditorInterface::generateRandomMap( const int32_t mapWidth )
     {
+        // The generator resets the map on its own, but the state of the editor has to be reset as well.
+        if ( !generateNewMap( mapWidth ) ) {
+            return false;
+        }
+
         return Maps::Random_Generator::generateMap( _mapFormat, _randomMapConfig, mapWidth, mapWidth );
     }
 
@@ -3116,30 +3121,10 @@ namespace Interface
             return false;
         }
 
-        _mapFormat = {};
-
-        world.generateUninitializedMap( mapWidth );
-
-        if ( world.w() != mapWidth || world.h() != mapWidth ) {
-            assert( 0 );
-
+        if ( !Maps::createEmptyMap( _mapFormat, mapWidth ) ) {
             return false;
         }
 
-        _mapFormat.width = mapWidth;
-
-        // Only square maps are supported so map height is the same as width.
-        const int32_t tilesCount = mapWidth * mapWidth;
-
-        _mapFormat.tiles.resize( tilesCount );
-
-        for ( int32_t i = 0; i < tilesCount; ++i ) {
-            world.getTile( i ).setIndex( i );
-            Maps::setTerrainOnTile( _mapFormat, i, Maps::Ground::WATER );
-        }
-
-        Maps::resetObjectUID();
-
         _loadedFileName.clear();
 
         conf.getCurrentMapInfo().version = GameVersion::RESURRECTION;
@@ -20,9 +20,13 @@
 
 #include "history_manager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "map_format_helper.h"
 #include "map_format_info.h"
@@ -45,78 +49,163 @@ namespace
         virtual bool prepare() = 0;
     };
 
-    // This class holds 2 copies of MapFormat objects in a compressed format:
-    // - one copy before the action
-    // - one copy after the action
+    // This class holds only the changes made by the action:
+    // - ranges of modified tiles with their states before and after the action
+    // - all other map information before and after the action if it was modified
+    // A full copy of tiles is kept only until the action is prepared to find out which tiles were modified.
     class GenericMapAction final : public BaseMapAction
     {
     public:
         explicit GenericMapAction( Maps::Map_Format::MapFormat & mapFormat )
             : _mapFormat( mapFormat )
+            , _beforeMapInfo( saveMapInfo( mapFormat ) )
+            , _tilesBefore( mapFormat.tiles )
             , _latestObjectUIDBefore( Maps::getLastObjectUID() )
         {
-            if ( !Maps::Map_Format::saveMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
-            }
+            // Do nothing.
         }
 
         bool prepare() override
         {
-            if ( !Maps::Map_Format::saveMap( _afterMapFormat, _mapFormat ) ) {
+            _afterMapInfo = saveMapInfo( _mapFormat );
+            if ( _beforeMapInfo.empty() || _afterMapInfo.empty() ) {
                 assert( 0 );
                 return false;
             }
 
             _latestObjectUIDAfter = Maps::getLastObjectUID();
 
+            if ( _beforeMapInfo == _afterMapInfo ) {
+                // Only tiles were modified.
+                _beforeMapInfo = {};
+                _afterMapInfo = {};
+                _isMapInfoChanged = false;
+            }
+
+            const std::vector<Maps::Map_Format::TileInfo> & tilesAfter = _mapFormat.tiles;
+
+            if ( _tilesBefore.size() != tilesAfter.size() ) {
+                // The whole map has been replaced.
+                _tileRanges.push_back( { 0, std::move( _tilesBefore ), tilesAfter } );
+            }
+            else {
+                for ( size_t tileId = 0; tileId < tilesAfter.size(); ++tileId ) {
+                    if ( _tilesBefore[tileId] == tilesAfter[tileId] ) {
+                        continue;
+                    }
+
+                    if ( _tileRanges.empty() || _tileRanges.back().firstTileId + _tileRanges.back().after.size() != tileId ) {
+                        _tileRanges.push_back( { tileId, {}, {} } );
+                    }
+
+                    _tileRanges.back().before.push_back( std::move( _tilesBefore[tileId] ) );
+                    _tileRanges.back().after.push_back( tilesAfter[tileId] );
+                }
+            }
+
+            _tilesBefore = {};
+            _isPrepared = true;
+
             return true;
         }
 
         bool redo() override
         {
-            if ( !Maps::Map_Format::loadMap( _afterMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
+            assert( _isPrepared );
+
+            for ( const TileRange & range : _tileRanges ) {
+                applyTiles( range.firstTileId, range.before.size(), range.after );
             }
 
-            _afterMapFormat.seek( 0 );
+            return updateMap( _afterMapInfo, _latestObjectUIDAfter );
+        }
 
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
-                // If this assertion blows up then something is really wrong with the Editor.
-                assert( 0 );
-                return false;
+        bool undo() override
+        {
+            if ( _isPrepared ) {
+                for ( auto iter = _tileRanges.rbegin(); iter != _tileRanges.rend(); ++iter ) {
+                    applyTiles( iter->firstTileId, iter->after.size(), iter->before );
+                }
+            }
+            else {
+                // The action was not committed so the changes are reverted using the full copy of tiles.
+                _mapFormat.tiles = _tilesBefore;
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDAfter );
+            return updateMap( _beforeMapInfo, _latestObjectUIDBefore );
+        }
 
-            return true;
+    private:
+        struct TileRange
+        {
+            size_t firstTileId{ 0 };
+
+            std::vector<Maps::Map_Format::TileInfo> before;
+            std::vector<Maps::Map_Format::TileInfo> after;
+        };
+
+        void applyTiles( const size_t firstTileId, const size_t replacedTileCount, const std::vector<Maps::Map_Format::TileInfo> & tiles )
+        {
+            std::vector<Maps::Map_Format::TileInfo> & mapTiles = _mapFormat.tiles;
+            assert( firstTileId + replacedTileCount <= mapTiles.size() );
+
+            if ( replacedTileCount == tiles.size() ) {
+                std::copy( tiles.begin(), tiles.end(), mapTiles.begin() + static_cast<std::ptrdiff_t>( firstTileId ) );
+                return;
+            }
+
+            const auto firstTileIter = mapTiles.begin() + static_cast<std::ptrdiff_t>( firstTileId );
+            mapTiles.insert( mapTiles.erase( firstTileIter, firstTileIter + static_cast<std::ptrdiff_t>( replacedTileCount ) ), tiles.begin(), tiles.end() );
         }
 
-        bool undo() override
+        static std::vector<uint8_t> saveMapInfo( const Maps::Map_Format::MapFormat & mapFormat )
         {
-            if ( !Maps::Map_Format::loadMap( _beforeMapFormat, _mapFormat ) ) {
+            RWStreamBuf stream;
+            stream.setBigendian( true );
+
+            if ( !Maps::Map_Format::saveMapWithoutTiles( stream, mapFormat ) ) {
                 assert( 0 );
-                return false;
+                return {};
             }
 
-            _beforeMapFormat.seek( 0 );
+            return { stream.data(), stream.data() + stream.size() };
+        }
+
+        bool updateMap( const std::vector<uint8_t> & mapInfo, const uint32_t latestObjectUID )
+        {
+            if ( _isMapInfoChanged ) {
+                ROStreamBuf stream( mapInfo );
+                stream.setBigendian( true );
+
+                if ( !Maps::Map_Format::loadMapWithoutTiles( stream, _mapFormat ) ) {
+                    assert( 0 );
+                    return false;
+                }
+            }
 
+            // The objects are placed on the Adventure Map in the order of their UIDs and can span many tiles
+            // so the world is rebuilt entirely.
             if ( !Maps::readMapInEditor( _mapFormat ) ) {
                 // If this assertion blows up then something is really wrong with the Editor.
                 assert( 0 );
                 return false;
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDBefore );
+            Maps::setLastObjectUID( latestObjectUID );
 
             return true;
         }
 
-    private:
         Maps::Map_Format::MapFormat & _mapFormat;
 
-        RWStreamBuf _beforeMapFormat;
-        RWStreamBuf _afterMapFormat;
+        std::vector<uint8_t> _beforeMapInfo;
+        std::vector<uint8_t> _afterMapInfo;
+
+        bool _isMapInfoChanged{ true };
+        bool _isPrepared{ false };
+
+        std::vector<Maps::Map_Format::TileInfo> _tilesBefore;
+        std::vector<TileRange> _tileRanges;
 
         const uint32_t _latestObjectUIDBefore{ 0 };
         uint32_t _latestObjectUIDAfter{ 0 };
@@ -334,3 +334,16 @@ bool Difficulty::isArtifactSortingAllowedForAI( const int32_t difficulty )
 
     return true;
 }
+
+bool Difficulty::isBattleSimulationAllowedForAI( const int32_t difficulty )
+{
+    switch ( difficulty ) {
+    case Difficulty::EASY:
+    case Difficulty::NORMAL:
+        return false;
+    default:
+        break;
+    }
+
+    return true;
+}
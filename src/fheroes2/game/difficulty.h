@@ -80,4 +80,7 @@ namespace Difficulty
     bool isBasicAIBattleLogicApplicable( const int32_t difficulty, const bool isControlledByHuman );
 
     bool isArtifactSortingAllowedForAI( const int32_t difficulty );
+
+    // Returns true if AI is allowed to simulate close fights with neutral armies in order to decide whether to attack them
+    bool isBattleSimulationAllowedForAI( const int32_t difficulty );
 }
@@ -352,7 +352,7 @@ int main( int argc, char ** argv )
                                                                timidityCfgPath );
 
         // Load palette.
-        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ) );
+        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ).toVector() );
         const fheroes2::Display & display = fheroes2::Display::instance();
         display.changePalette( nullptr, true );
 
@@ -138,6 +138,13 @@ void Interface::AdventureMap::redraw( const uint32_t force )
             _controlPanel._redraw();
         }
     }
+    else if ( combinedRedraw & REDRAW_GAMEAREA_TILES ) {
+        _gameArea.RedrawDirtyTiles( fheroes2::Display::instance(), LEVEL_ALL );
+
+        if ( hideInterface && conf.ShowControlPanel() ) {
+            _controlPanel._redraw();
+        }
+    }
 
     if ( ( hideInterface && conf.ShowRadar() ) || ( combinedRedraw & ( REDRAW_RADAR_CURSOR | REDRAW_RADAR ) ) ) {
         // Redraw radar map only if `REDRAW_RADAR` is set.
@@ -169,6 +176,25 @@ void Interface::AdventureMap::redraw( const uint32_t force )
     _redraw = 0;
 }
 
+void Interface::AdventureMap::redrawAndRender()
+{
+    fheroes2::Display & display = fheroes2::Display::instance();
+
+    // When the interface is hidden its items are drawn over the game area so they have to be rendered as well.
+    if ( _lockRedraw || _redraw != REDRAW_GAMEAREA_TILES || Settings::Get().isHideInterfaceEnabled() ) {
+        redraw( 0 );
+        display.render();
+        return;
+    }
+
+    const fheroes2::Rect roi = _gameArea.RedrawDirtyTiles( display, LEVEL_ALL );
+    _redraw = 0;
+
+    if ( roi.width > 0 && roi.height > 0 ) {
+        display.render( roi );
+    }
+}
+
 int32_t Interface::AdventureMap::GetDimensionDoorDestination( const int32_t from, const int32_t distance, const bool water )
 {
     fheroes2::Display & display = fheroes2::Display::instance();
@@ -91,6 +91,10 @@ namespace Interface
 
         void redraw( const uint32_t force ) override;
 
+        // Redraws all planned interface items and renders them on the screen. If only the dirty tiles of the game area
+        // are planned for redraw then only the area around them is rendered.
+        void redrawAndRender();
+
         int32_t GetDimensionDoorDestination( const int32_t from, const int32_t distance, const bool water );
 
         IconsPanel & GetIconsPanel()
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <ctime>
 #include <ostream>
@@ -57,6 +58,9 @@ namespace
 
     const uint16_t saveFileMagicNumber{ 0xFF03 };
 
+    // Save data is compressed in blocks of this size in parallel, and the blocks are decompressed in parallel on load.
+    const size_t saveFileCompressionBlockSize{ 512 * 1024 };
+
     uint16_t versionOfCurrentSaveFile = CURRENT_FORMAT_VERSION;
 
     std::string lastSaveName;
@@ -152,7 +156,7 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
 
     // End-of-data marker
     dataStream << saveFileMagicNumber;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
+    if ( dataStream.fail() || !Compression::zipStreamBufInBlocks( dataStream, fileStream, saveFileCompressionBlockSize ) ) {
         return false;
     }
 
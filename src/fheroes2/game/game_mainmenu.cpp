@@ -60,6 +60,7 @@
 #include "ui_dialog.h"
 #include "ui_language.h"
 #include "ui_tool.h"
+#include "view_world.h"
 
 namespace
 {
@@ -218,6 +219,9 @@ fheroes2::GameMode Game::MainMenu( const bool isFirstGameRun )
 
     conf.SetGameType( TYPE_MENU );
 
+    // The world map images kept by the View World window are not needed until a game is started or loaded.
+    ViewWorld::resetCache();
+
     // setup cursor
     const CursorRestorer cursorRestorer( true, Cursor::POINTER );
 
@@ -342,6 +342,9 @@ void Game::OpenCastleDialog( Castle & castle, bool updateFocus /* = true */, con
         result = ( *it )->OpenDialog( openConstructionWindow, openMageGuildWindow, false, renderBackgroundDialog );
     }
 
+    // The castle screen is closed so none of its building sprites are in use anymore.
+    fheroes2::AGG::trimICNCache();
+
     // If Castle dialog background was not rendered than we have opened it from other dialog (Kingdom Overview)
     // and there is no need update Adventure map interface at this time.
     if ( renderBackgroundDialog ) {
@@ -1535,16 +1538,22 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         if ( Game::validateAnimationDelay( Game::DelayType::MAPS_DELAY ) ) {
             Game::updateAdventureMapAnimationIndex();
 
-            _gameArea.SetRedraw();
+            _gameArea.markAnimatedTilesDirty();
         }
 
         if ( needRedraw() ) {
-            redraw( 0 );
+            if ( getRedrawMask() == REDRAW_GAMEAREA_TILES && !Game::isFadeInNeeded() ) {
+                // Only the animated objects have changed so only the area around them is redrawn and rendered.
+                redrawAndRender();
+            }
+            else {
+                redraw( 0 );
 
-            // If this assertion blows up it means that we are holding a RedrawLocker lock for rendering which should not happen.
-            assert( getRedrawMask() == 0 );
+                // If this assertion blows up it means that we are holding a RedrawLocker lock for rendering which should not happen.
+                assert( getRedrawMask() == 0 );
 
-            validateFadeInAndRender();
+                validateFadeInAndRender();
+            }
         }
     }
 
@@ -55,7 +55,10 @@ namespace Interface
         REDRAW_ALL = 0x1FF,
 
         // This option is only for the Editor.
-        REDRAW_PASSABILITIES = 0x200
+        REDRAW_PASSABILITIES = 0x200,
+
+        // To redraw only the area around the game area tiles marked as dirty. It is ignored if REDRAW_GAMEAREA is set.
+        REDRAW_GAMEAREA_TILES = 0x400
     };
 
     class BaseInterface
@@ -46,10 +46,12 @@
 #include "interface_cpanel.h"
 #include "localevent.h"
 #include "logging.h"
+#include "map_object_info.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "maps_tiles_render.h"
+#include "math_tools.h"
 #include "pal.h"
 #include "players.h"
 #include "route.h"
@@ -65,6 +67,24 @@ namespace
 {
     const int32_t minimalRequiredDraggingMovement = 10;
 
+    // Object sprites are not limited by the size of a tile. Hero, boat and monster sprites stick out of their tiles
+    // by up to 2 tiles in the top direction and by 1 tile in other directions, the same goes for multi-tile objects
+    // disappearing with fading animation. All these tiles must be redrawn together with a dirty tile.
+    const int32_t dirtyTileHorizontalMargin = 1;
+    const int32_t dirtyTileTopMargin = 2;
+    const int32_t dirtyTileBottomMargin = 1;
+
+    bool isObjectPartAnimated( const Maps::ObjectPart & part )
+    {
+        if ( part.icnType == MP2::OBJ_ICN_TYPE_UNKNOWN ) {
+            return false;
+        }
+
+        const auto * objectInfo = Maps::getObjectPartByIcn( part.icnType, part.icnIndex );
+
+        return objectInfo != nullptr && objectInfo->animationFrames > 0;
+    }
+
     static_assert( std::is_trivially_copyable<fheroes2::ObjectRenderingInfo>::value, "This class is not trivially copyable anymore. Add std::move where required." );
 
     struct TileUnfitRenderObjectInfo
@@ -343,6 +363,8 @@ void Interface::GameArea::generate( const fheroes2::Size & screenSize, const boo
 void Interface::GameArea::SetAreaPosition( int32_t x, int32_t y, int32_t w, int32_t h )
 {
     _windowROI = { x, y, w, h };
+    _renderROI = _windowROI;
+
     const fheroes2::Size worldSize( world.w() * fheroes2::tileWidthPx, world.h() * fheroes2::tileWidthPx );
 
     if ( worldSize.width > w ) {
@@ -375,7 +397,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
                          overlappedRoi.height, alpha, flip );
@@ -387,7 +409,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, srcRoi.width, srcRoi.height };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, srcRoi.x + overlappedRoi.x - imageRoi.x, srcRoi.y + overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y,
                          overlappedRoi.width, overlappedRoi.height, alpha, flip );
@@ -398,15 +420,158 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x, tileOffset.y, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::Copy( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width, overlappedRoi.height );
 }
 
 void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
 {
-    const fheroes2::Rect & tileROI = GetVisibleTileROI();
+    // The whole game area is going to be redrawn so all dirty tiles are going to be updated as well.
+    _dirtyTiles.clear();
+
+    _redrawTiles( dst, flag, isPuzzleDraw, GetVisibleTileROI() );
+
+    updateObjectAnimationInfo();
+}
+
+fheroes2::Rect Interface::GameArea::RedrawDirtyTiles( fheroes2::Image & dst, int flag ) const
+{
+    fheroes2::Rect redrawnRoi;
+
+    for ( const fheroes2::Rect & tileArea : _getDirtyTileAreas() ) {
+        const fheroes2::Point areaOffset = GetRelativeTilePosition( tileArea.getPosition() );
+
+        _renderROI = _windowROI ^ fheroes2::Rect{ areaOffset.x, areaOffset.y, tileArea.width * fheroes2::tileWidthPx, tileArea.height * fheroes2::tileWidthPx };
+        if ( _renderROI.width <= 0 || _renderROI.height <= 0 ) {
+            // This area is outside the visible part of the game area.
+            continue;
+        }
+
+        _redrawTiles( dst, flag, false, tileArea );
+
+        redrawnRoi = fheroes2::getBoundaryRect( redrawnRoi, _renderROI );
+    }
+
+    _renderROI = _windowROI;
+    _dirtyTiles.clear();
+
+    updateObjectAnimationInfo();
+
+    return redrawnRoi;
+}
+
+void Interface::GameArea::markTileDirty( const int32_t tileIndex )
+{
+    if ( !Maps::isValidAbsIndex( tileIndex ) ) {
+        assert( 0 );
+        return;
+    }
+
+    _dirtyTiles.push_back( tileIndex );
+
+    _interface.setRedraw( REDRAW_GAMEAREA_TILES );
+}
+
+void Interface::GameArea::markAnimatedTilesDirty()
+{
+    const fheroes2::Rect visibleTileROI = GetVisibleTileROI();
+
+    const int32_t worldWidth = world.w();
+    const int32_t minX = std::max( visibleTileROI.x, 0 );
+    const int32_t minY = std::max( visibleTileROI.y, 0 );
+    const int32_t maxX = std::min( visibleTileROI.x + visibleTileROI.width, worldWidth );
+    const int32_t maxY = std::min( visibleTileROI.y + visibleTileROI.height, world.h() );
+
+    std::vector<int32_t> animatedTiles;
 
+    for ( int32_t y = minY; y < maxY; ++y ) {
+        const int32_t offset = y * worldWidth;
+
+        for ( int32_t x = minX; x < maxX; ++x ) {
+            const int32_t tileIndex = offset + x;
+            const Maps::Tile & tile = world.getTile( tileIndex );
+            const MP2::MapObjectType objectType = tile.getMainObjectType();
+
+            // Hero flags are waving. Heroes are rendered even partially under the fog.
+            if ( objectType == MP2::OBJ_HERO ) {
+                animatedTiles.push_back( tileIndex );
+                continue;
+            }
+
+            if ( objectType == MP2::OBJ_ABANDONED_MINE || ( objectType == MP2::OBJ_MINE && Maps::getMineSpellIdFromTile( tile ) == Spell::HAUNT ) ) {
+                // Flying ghosts stick out of the mine tile further than other sprites so the neighboring tiles are redrawn as well.
+                for ( int32_t ghostY = std::max( y - 1, 0 ); ghostY <= y; ++ghostY ) {
+                    for ( int32_t ghostX = std::max( x - 1, 0 ); ghostX <= std::min( x + 1, worldWidth - 1 ); ++ghostX ) {
+                        animatedTiles.push_back( ghostY * worldWidth + ghostX );
+                    }
+                }
+
+                continue;
+            }
+
+            // Objects fully under the fog are not rendered.
+            if ( tile.getFogDirection() == DIRECTION_ALL ) {
+                continue;
+            }
+
+            if ( objectType == MP2::OBJ_MONSTER || isObjectPartAnimated( tile.getMainObjectPart() )
+                 || std::any_of( tile.getGroundObjectParts().begin(), tile.getGroundObjectParts().end(), isObjectPartAnimated )
+                 || std::any_of( tile.getTopObjectParts().begin(), tile.getTopObjectParts().end(), isObjectPartAnimated ) ) {
+                animatedTiles.push_back( tileIndex );
+            }
+        }
+    }
+
+    // Every dirty tile is redrawn together with its neighbors. If animated objects cover a large part of the game area
+    // then it is cheaper to redraw the whole game area at once.
+    const size_t tilesPerDirtyTile = ( 2 * dirtyTileHorizontalMargin + 1 ) * ( dirtyTileTopMargin + dirtyTileBottomMargin + 1 );
+    if ( animatedTiles.size() * tilesPerDirtyTile > static_cast<size_t>( visibleTileROI.width * visibleTileROI.height ) / 2 ) {
+        SetRedraw();
+        return;
+    }
+
+    for ( const int32_t tileIndex : animatedTiles ) {
+        markTileDirty( tileIndex );
+    }
+}
+
+std::vector<fheroes2::Rect> Interface::GameArea::_getDirtyTileAreas() const
+{
+    std::vector<fheroes2::Rect> areas;
+    areas.reserve( _dirtyTiles.size() );
+
+    for ( const int32_t tileIndex : _dirtyTiles ) {
+        const fheroes2::Point tilePos = Maps::GetPoint( tileIndex );
+
+        fheroes2::Rect area{ tilePos.x - dirtyTileHorizontalMargin, tilePos.y - dirtyTileTopMargin, 2 * dirtyTileHorizontalMargin + 1,
+                             dirtyTileTopMargin + dirtyTileBottomMargin + 1 };
+
+        // Merge the area with all already existing areas that it overlaps. The merged area can overlap other areas so we repeat it until
+        // there is nothing to merge. The number of dirty tiles is usually very small so there is no need for anything more sophisticated.
+        bool isMerged = true;
+        while ( isMerged ) {
+            isMerged = false;
+
+            for ( auto iter = areas.begin(); iter != areas.end(); ++iter ) {
+                const fheroes2::Rect intersection = area ^ *iter;
+                if ( intersection.width > 0 && intersection.height > 0 ) {
+                    area = fheroes2::getBoundaryRect( area, *iter );
+                    areas.erase( iter );
+                    isMerged = true;
+                    break;
+                }
+            }
+        }
+
+        areas.push_back( area );
+    }
+
+    return areas;
+}
+
+void Interface::GameArea::_redrawTiles( fheroes2::Image & dst, const int flag, const bool isPuzzleDraw, const fheroes2::Rect & tileROI ) const
+{
     int32_t maxX = tileROI.x + tileROI.width;
     int32_t maxY = tileROI.y + tileROI.height;
     const int32_t worldWidth = world.w();
@@ -791,8 +956,6 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
             }
         }
     }
-
-    updateObjectAnimationInfo();
 }
 
 void Interface::GameArea::renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const
@@ -1205,13 +1368,14 @@ void Interface::GameArea::runSingleObjectAnimation( const std::shared_ptr<BaseOb
     addObjectAnimationInfo( info );
 
     LocalEvent & le = LocalEvent::Get();
-    fheroes2::Display & display = fheroes2::Display::instance();
     Interface::AdventureMap & adventureMapInterface = Interface::AdventureMap::Get();
 
     while ( le.HandleEvents( Game::isDelayNeeded( { Game::DelayType::HEROES_PICKUP_DELAY } ) ) && !info->isAnimationCompleted() ) {
         if ( Game::validateAnimationDelay( Game::DelayType::HEROES_PICKUP_DELAY ) ) {
-            adventureMapInterface.redraw( Interface::REDRAW_GAMEAREA );
-            display.render();
+            // Nothing else is changing on the Adventure Map during this animation so it is enough to redraw only the animated object.
+            markTileDirty( info->tileId );
+
+            adventureMapInterface.redrawAndRender();
         }
     }
 }
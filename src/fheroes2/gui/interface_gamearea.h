@@ -198,6 +198,18 @@ namespace Interface
         // Interface::BaseInterface::Redraw() instead to avoid issues in the "no interface" mode
         void Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw = false ) const;
 
+        // Redraws only the area around the tiles marked as dirty and returns the bounding rectangle of the redrawn area in screen coordinates.
+        // The rest of the game area must be already rendered in the destination image.
+        fheroes2::Rect RedrawDirtyTiles( fheroes2::Image & dst, int flag ) const;
+
+        // Marks the tile as changed since the last redraw. If nothing else needs to be redrawn on the Adventure Map then only the area around
+        // dirty tiles is redrawn. A full redraw of the game area clears the list of dirty tiles.
+        void markTileDirty( const int32_t tileIndex );
+
+        // Marks all visible tiles with animated objects (monsters, hero flags, flying ghosts and animated object parts) as dirty
+        // to redraw them on the next map animation tick. Plans a full redraw of the game area if there are too many of them.
+        void markAnimatedTilesDirty();
+
         void renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const;
 
         void BlitOnTile( fheroes2::Image & dst, const fheroes2::Image & src, int32_t ox, int32_t oy, const fheroes2::Point & mp, bool flip, uint8_t alpha ) const;
@@ -270,6 +282,9 @@ namespace Interface
         BaseInterface & _interface;
 
         fheroes2::Rect _windowROI; // visible to draw area of World Map in pixels
+
+        // The area in pixels to which all drawing is clipped. It is the same as window ROI unless only dirty tiles are being redrawn.
+        mutable fheroes2::Rect _renderROI;
         fheroes2::Point _topLeftTileOffset; // offset of tiles to be drawn (from here we can find any tile ID)
 
         // boundaries for World Map
@@ -289,6 +304,9 @@ namespace Interface
         // This member needs to be mutable because it is modified during rendering.
         mutable std::vector<std::shared_ptr<BaseObjectAnimationInfo>> _animationInfo;
 
+        // Tiles changed since the last redraw. This member needs to be mutable because it is cleared during rendering.
+        mutable std::vector<int32_t> _dirtyTiles;
+
         fheroes2::Point _lastMouseDragPosition;
         fheroes2::Point _mousePositionForFastScroll;
         bool _mouseDraggingInitiated{ false };
@@ -307,6 +325,12 @@ namespace Interface
 
         void _setCenterToTile( const fheroes2::Point & tile ); // set center to the middle of tile (input is tile ID)
 
+        // Renders the given tiles with the clipping to the render ROI. Tile ROI might be partially or fully outside the world map.
+        void _redrawTiles( fheroes2::Image & dst, const int flag, const bool isPuzzleDraw, const fheroes2::Rect & tileROI ) const;
+
+        // Returns non-overlapping areas (in tiles) which must be redrawn to update all dirty tiles.
+        std::vector<fheroes2::Rect> _getDirtyTileAreas() const;
+
         void updateObjectAnimationInfo() const;
     };
 }
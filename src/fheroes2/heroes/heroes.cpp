@@ -1185,6 +1185,37 @@ void Heroes::ActionAfterBattle()
     SetModes( ACTION );
 }
 
+void Heroes::copyBattlePropertiesTo( Heroes & hero ) const
+{
+    assert( &hero != this );
+
+    hero.attack = attack;
+    hero.defense = defense;
+    hero.power = power;
+    hero.knowledge = knowledge;
+
+    hero.modes = modes;
+    hero._spellPoints = _spellPoints;
+    hero._spellBook = _spellBook;
+    hero._bagArtifacts = _bagArtifacts;
+
+    hero.SetColor( GetColor() );
+    hero.SetCenter( GetCenter() );
+
+    hero._experience = _experience;
+    hero._name = _name;
+    hero._secondarySkills.ToVector() = _secondarySkills.ToVector();
+
+    hero._army.Assign( _army );
+    hero._army.SetSpreadFormation( _army.isSpreadFormation() );
+
+    hero._id = _id;
+    hero._portrait = _portrait;
+    hero._race = _race;
+
+    hero._visitedObjects = _visitedObjects;
+}
+
 uint32_t Heroes::getDailyRestoredSpellPoints() const
 {
     uint32_t points = GameStatic::GetHeroesRestoreSpellPointsPerDay();
@@ -497,6 +497,10 @@ public:
     void ActionAfterBattle() override;
     void ActionPreBattle() override;
 
+    // Copies the properties of this hero that affect battles (skills, army, artifacts, spells, visited objects, color
+    // and position) to another hero. This other hero can then be used to simulate a battle without changing this hero.
+    void copyBattlePropertiesTo( Heroes & hero ) const;
+
     bool BuySpellBook( const Castle & castle );
 
     const Route::Path & GetPath() const
@@ -45,7 +45,6 @@
 #include "math_base.h"
 #include "mp2.h"
 #include "route.h"
-#include "screen.h"
 #include "settings.h"
 #include "world.h"
 
@@ -520,7 +519,6 @@ void Heroes::FadeOut( const int animSpeedMultiplier, const fheroes2::Point & off
     Interface::AdventureMap & iface = Interface::AdventureMap::Get();
     Interface::GameArea & gamearea = iface.getGameArea();
 
-    fheroes2::Display & display = fheroes2::Display::instance();
     LocalEvent & le = LocalEvent::Get();
 
     _alphaValue = 255;
@@ -532,10 +530,16 @@ void Heroes::FadeOut( const int animSpeedMultiplier, const fheroes2::Point & off
 
         if ( offset.x != 0 || offset.y != 0 ) {
             gamearea.ShiftCenter( offset );
+
+            iface.setRedraw( Interface::REDRAW_GAMEAREA );
         }
 
         if ( Game::validateAnimationDelay( Game::DelayType::MAPS_DELAY ) ) {
             Game::updateAdventureMapAnimationIndex();
+
+            // All animated objects have to be redrawn.
+            iface.setRedraw( Interface::REDRAW_GAMEAREA );
+
             if ( isControlAI() ) {
                 // Draw hourglass sand grains animation.
                 iface.setRedraw( Interface::REDRAW_STATUS );
@@ -544,9 +548,9 @@ void Heroes::FadeOut( const int animSpeedMultiplier, const fheroes2::Point & off
 
         _alphaValue = std::max( 0, _alphaValue - 8 * animSpeedMultiplier );
 
-        iface.redraw( Interface::REDRAW_GAMEAREA );
+        gamearea.markTileDirty( GetIndex() );
 
-        display.render();
+        iface.redrawAndRender();
     }
 
     _alphaValue = 255;
@@ -563,7 +567,6 @@ void Heroes::FadeIn( const int animSpeedMultiplier, const fheroes2::Point & offs
     Interface::AdventureMap & iface = Interface::AdventureMap::Get();
     Interface::GameArea & gamearea = iface.getGameArea();
 
-    fheroes2::Display & display = fheroes2::Display::instance();
     LocalEvent & le = LocalEvent::Get();
 
     _alphaValue = 0;
@@ -575,10 +578,16 @@ void Heroes::FadeIn( const int animSpeedMultiplier, const fheroes2::Point & offs
 
         if ( offset.x != 0 || offset.y != 0 ) {
             gamearea.ShiftCenter( offset );
+
+            iface.setRedraw( Interface::REDRAW_GAMEAREA );
         }
 
         if ( Game::validateAnimationDelay( Game::DelayType::MAPS_DELAY ) ) {
             Game::updateAdventureMapAnimationIndex();
+
+            // All animated objects have to be redrawn.
+            iface.setRedraw( Interface::REDRAW_GAMEAREA );
+
             if ( isControlAI() ) {
                 // Draw hourglass sand grains animation.
                 iface.setRedraw( Interface::REDRAW_STATUS );
@@ -587,9 +596,9 @@ void Heroes::FadeIn( const int animSpeedMultiplier, const fheroes2::Point & offs
 
         _alphaValue = std::min( _alphaValue + 8 * animSpeedMultiplier, 255 );
 
-        iface.redraw( Interface::REDRAW_GAMEAREA );
+        gamearea.markTileDirty( GetIndex() );
 
-        display.render();
+        iface.redrawAndRender();
     }
 
     _alphaValue = 255;
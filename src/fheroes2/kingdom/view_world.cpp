@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -45,10 +46,12 @@
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "mp2.h"
+#include "rand.h"
 #include "render_processor.h"
 #include "resource.h"
 #include "screen.h"
 #include "settings.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_button.h"
 #include "ui_constants.h"
@@ -186,70 +189,133 @@ namespace
         }
     }
 
-    struct CacheForMapWithResources
+    // Returns a value which changes whenever anything rendered on the tile by the Game Area changes.
+    uint64_t getTileRenderingFingerprint( const Maps::Tile & tile, const bool isFogRendered )
     {
-        std::vector<fheroes2::Image> cachedImages; // One image per zoom Level
+        uint64_t fingerprint = 0;
 
-        CacheForMapWithResources() = delete;
+        Rand::combineSeedWithValueHash( fingerprint, tile.getTerrainImageIndex() );
+        Rand::combineSeedWithValueHash( fingerprint, tile.getTerrainFlags() );
+        Rand::combineSeedWithValueHash( fingerprint, tile.getMainObjectType( false ) );
+        Rand::combineSeedWithValueHash( fingerprint, tile.getMainObjectType( true ) );
+        Rand::combineSeedWithValueHash( fingerprint, tile.getBoatOwnerColor() );
 
-        // Compute complete world map, and save it for all zoom levels
-        explicit CacheForMapWithResources( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels )
+        if ( isFogRendered ) {
+            Rand::combineSeedWithValueHash( fingerprint, tile.getFogDirection() );
+        }
+
+        for ( const uint32_t value : tile.metadata() ) {
+            Rand::combineSeedWithValueHash( fingerprint, value );
+        }
+
+        const auto combineObjectPart = [&fingerprint]( const Maps::ObjectPart & part ) {
+            Rand::combineSeedWithValueHash( fingerprint, part._uid );
+            Rand::combineSeedWithValueHash( fingerprint, part.layerType );
+            Rand::combineSeedWithValueHash( fingerprint, part.icnType );
+            Rand::combineSeedWithValueHash( fingerprint, part.icnIndex );
+        };
+
+        combineObjectPart( tile.getMainObjectPart() );
+
+        for ( const Maps::ObjectPart & part : tile.getGroundObjectParts() ) {
+            combineObjectPart( part );
+        }
+
+        // Separate the ground and the top object parts, so that moving a part from one list to another changes the fingerprint.
+        Rand::combineSeedWithValueHash( fingerprint, tile.getGroundObjectParts().size() );
+
+        for ( const Maps::ObjectPart & part : tile.getTopObjectParts() ) {
+            combineObjectPart( part );
+        }
+
+        return fingerprint;
+    }
+
+    // The world map rendered by the Game Area for every zoom level of the View World window. It is kept between openings of the window
+    // and only the blocks of tiles whose rendering has changed since the previous opening are rendered again.
+    class WorldMapImageCache
+    {
+    public:
+        const std::vector<fheroes2::Image> & update( const int32_t drawingFlags, Interface::GameArea & gameArea, const size_t zoomLevels )
         {
-            cachedImages.resize( zoomLevels );
+            // The images take a lot of memory on big maps, so only the ones for the last used drawing flags are kept.
+            if ( drawingFlags != _drawingFlags ) {
+                reset();
 
-            for ( size_t i = 0; i < zoomLevels; ++i ) {
-                cachedImages[i]._disableTransformLayer();
-                cachedImages[i].resize( world.w() * tileSizePerZoomLevel[i], world.h() * tileSizePerZoomLevel[i] );
+                _drawingFlags = drawingFlags;
             }
 
-            const int32_t blockSizeX = 18;
-            const int32_t blockSizeY = 18;
-
             const int32_t worldWidth = world.w();
             const int32_t worldHeight = world.h();
 
             // Assert will fail in case we add non-standard map sizes, otherwise standard map sizes are multiples of 18 tiles
-            assert( worldWidth % blockSizeX == 0 );
-            assert( worldHeight % blockSizeY == 0 );
+            assert( worldWidth % blockSize == 0 );
+            assert( worldHeight % blockSize == 0 );
+
+            const int32_t blocksX = worldWidth / blockSize;
+            const int32_t blocksY = worldHeight / blockSize;
+
+            if ( _images.size() != zoomLevels || worldWidth != _worldWidth || worldHeight != _worldHeight ) {
+                _worldWidth = worldWidth;
+                _worldHeight = worldHeight;
 
-            const int32_t redrawAreaWidth = blockSizeX * fheroes2::tileWidthPx;
-            const int32_t redrawAreaHeight = blockSizeY * fheroes2::tileWidthPx;
-            const int32_t redrawAreaCenterX = blockSizeX * fheroes2::tileWidthPx / 2;
-            const int32_t redrawAreaCenterY = blockSizeY * fheroes2::tileWidthPx / 2;
+                _images.resize( zoomLevels );
+
+                for ( size_t i = 0; i < zoomLevels; ++i ) {
+                    _images[i]._disableTransformLayer();
+                    _images[i].resize( worldWidth * tileSizePerZoomLevel[i], worldHeight * tileSizePerZoomLevel[i] );
+                }
+
+                _blockFingerprints.clear();
+            }
+
+            const std::vector<fheroes2::Point> dirtyBlocks = _updateBlockFingerprints( ( drawingFlags & Interface::RedrawLevelType::LEVEL_FOG ) != 0, blocksX, blocksY );
+            if ( dirtyBlocks.empty() ) {
+                return _images;
+            }
 
-            // Create temporary image where we will draw blocks of the main map on
-            fheroes2::Image temporaryImg;
-            temporaryImg._disableTransformLayer();
-            temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
+            const int32_t redrawAreaWidth = blockSize * fheroes2::tileWidthPx;
+            const int32_t redrawAreaHeight = blockSize * fheroes2::tileWidthPx;
+            const int32_t redrawAreaCenterX = blockSize * fheroes2::tileWidthPx / 2;
+            const int32_t redrawAreaCenterY = blockSize * fheroes2::tileWidthPx / 2;
 
             // Remember the original game area ROI and center of the view.
             const fheroes2::Rect gameAreaRoi( gameArea.GetROI() );
             const fheroes2::Point gameAreaCenter( gameArea.getCurrentCenterInPixels() );
 
             gameArea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
-            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
-            if ( viewMode == ViewWorldMode::ViewAll ) {
-                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
-            }
-            else if ( viewMode == ViewWorldMode::ViewTowns ) {
-                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
+
+            // The Game Area and the sprite cache can only be used by one thread, so the blocks are rendered sequentially in batches.
+            // Each batch is then scaled down to all zoom levels in parallel, one zoom level per thread.
+            const size_t batchSize = std::min<size_t>( dirtyBlocks.size(), 16 );
+
+            std::vector<fheroes2::Image> blockImages( batchSize );
+            for ( fheroes2::Image & image : blockImages ) {
+                image._disableTransformLayer();
+                image.resize( redrawAreaWidth, redrawAreaHeight );
             }
 
-#if !defined( SAVE_WORLD_MAP )
-            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
-#endif
+            for ( size_t batchStart = 0; batchStart < dirtyBlocks.size(); batchStart += batchSize ) {
+                const size_t batchEnd = std::min( batchStart + batchSize, dirtyBlocks.size() );
 
-            // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
-            for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
-                for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
-                    gameArea.SetCenterInPixels( { x * fheroes2::tileWidthPx + redrawAreaCenterX, y * fheroes2::tileWidthPx + redrawAreaCenterY } );
-                    gameArea.Redraw( temporaryImg, drawingFlags );
+                for ( size_t blockId = batchStart; blockId < batchEnd; ++blockId ) {
+                    const fheroes2::Point & block = dirtyBlocks[blockId];
 
-                    for ( size_t i = 0; i < zoomLevels; ++i ) {
-                        fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), cachedImages[i], x * tileSizePerZoomLevel[i],
-                                          y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
-                    }
+                    gameArea.SetCenterInPixels( { block.x * fheroes2::tileWidthPx + redrawAreaCenterX, block.y * fheroes2::tileWidthPx + redrawAreaCenterY } );
+                    gameArea.Redraw( blockImages[blockId - batchStart], drawingFlags );
                 }
+
+                MultiThreading::executeInParallel( zoomLevels, [this, &dirtyBlocks, &blockImages, batchStart, batchEnd]( const size_t zoomLevelId ) {
+                    const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
+
+                    for ( size_t blockId = batchStart; blockId < batchEnd; ++blockId ) {
+                        const fheroes2::Image & blockImage = blockImages[blockId - batchStart];
+                        const fheroes2::Point & block = dirtyBlocks[blockId];
+
+                        fheroes2::Resize( blockImage, 0, 0, blockImage.width(), blockImage.height(), _images[zoomLevelId], block.x * tileSize, block.y * tileSize,
+                                          blockSize * tileSize, blockSize * tileSize );
+                    }
+                } );
             }
 
             // Restore the original game area ROI and center of the view.
@@ -257,21 +323,131 @@ namespace
             gameArea.SetCenterInPixels( gameAreaCenter );
 
 #if defined( SAVE_WORLD_MAP )
-            fheroes2::Save( cachedImages[3], Settings::Get().getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
+            fheroes2::Save( _images[3], Settings::Get().getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
 #endif
+
+            return _images;
         }
 
-        size_t getZoomLevels() const
+        void reset()
         {
-            return cachedImages.size();
+            *this = {};
+        }
+
+    private:
+        static constexpr int32_t blockSize{ 18 };
+
+        // Object sprites stick out of their tiles by up to 2 tiles and the fog of a tile depends on its neighbours,
+        // so the tiles around a block are taken into account as well.
+        static constexpr int32_t blockMargin{ 2 };
+
+        // Returns the top-left tile of every block whose fingerprint has changed.
+        std::vector<fheroes2::Point> _updateBlockFingerprints( const bool isFogRendered, const int32_t blocksX, const int32_t blocksY )
+        {
+            std::vector<uint64_t> tileFingerprints( static_cast<size_t>( _worldWidth ) * _worldHeight );
+            for ( size_t i = 0; i < tileFingerprints.size(); ++i ) {
+                tileFingerprints[i] = getTileRenderingFingerprint( world.getTile( static_cast<int32_t>( i ) ), isFogRendered );
+            }
+
+            const bool isFullRedraw = _blockFingerprints.empty();
+            _blockFingerprints.resize( static_cast<size_t>( blocksX ) * blocksY );
+
+            std::vector<fheroes2::Point> dirtyBlocks;
+
+            for ( int32_t blockY = 0; blockY < blocksY; ++blockY ) {
+                const int32_t minY = std::max( blockY * blockSize - blockMargin, 0 );
+                const int32_t maxY = std::min( ( blockY + 1 ) * blockSize + blockMargin, _worldHeight );
+
+                for ( int32_t blockX = 0; blockX < blocksX; ++blockX ) {
+                    const int32_t minX = std::max( blockX * blockSize - blockMargin, 0 );
+                    const int32_t maxX = std::min( ( blockX + 1 ) * blockSize + blockMargin, _worldWidth );
+
+                    uint64_t fingerprint = 0;
+                    for ( int32_t y = minY; y < maxY; ++y ) {
+                        const size_t offset = static_cast<size_t>( y ) * _worldWidth;
+                        for ( int32_t x = minX; x < maxX; ++x ) {
+                            Rand::combineSeedWithValueHash( fingerprint, tileFingerprints[offset + x] );
+                        }
+                    }
+
+                    uint64_t & blockFingerprint = _blockFingerprints[static_cast<size_t>( blockY ) * blocksX + blockX];
+                    if ( isFullRedraw || fingerprint != blockFingerprint ) {
+                        blockFingerprint = fingerprint;
+                        dirtyBlocks.emplace_back( blockX * blockSize, blockY * blockSize );
+                    }
+                }
+            }
+
+            return dirtyBlocks;
+        }
+
+        std::vector<fheroes2::Image> _images;
+
+        std::vector<uint64_t> _blockFingerprints;
+
+        int32_t _worldWidth{ 0 };
+        int32_t _worldHeight{ 0 };
+
+        int32_t _drawingFlags{ 0 };
+    };
+
+    WorldMapImageCache worldMapImageCache;
+
+    struct CacheForMapWithResources
+    {
+        // One image per zoom level, shared between openings of the window.
+        const std::vector<fheroes2::Image> & mapImages;
+
+        // A copy of the map images with object icons drawn on top of them. It is empty if no icons are drawn.
+        std::vector<fheroes2::Image> imagesWithIcons;
+
+        CacheForMapWithResources() = delete;
+
+        // Bring the world map for all zoom levels up to date
+        explicit CacheForMapWithResources( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels )
+            : mapImages( worldMapImageCache.update( getDrawingFlags( viewMode ), gameArea, zoomLevels ) )
+        {
+            // Do nothing.
+        }
+
+        const std::vector<fheroes2::Image> & getImages() const
+        {
+            return imagesWithIcons.empty() ? mapImages : imagesWithIcons;
+        }
+
+        std::vector<fheroes2::Image> & getImagesForIcons()
+        {
+            if ( imagesWithIcons.empty() ) {
+                imagesWithIcons = mapImages;
+            }
+
+            return imagesWithIcons;
+        }
+
+    private:
+        static int32_t getDrawingFlags( const ViewWorldMode viewMode )
+        {
+            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
+            if ( viewMode == ViewWorldMode::ViewAll ) {
+                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
+            }
+            else if ( viewMode == ViewWorldMode::ViewTowns ) {
+                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
+            }
+
+#if !defined( SAVE_WORLD_MAP )
+            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
+#endif
+
+            return drawingFlags;
         }
     };
 
-    void DrawWorld( const ViewWorld::ZoomROIs & ROI, CacheForMapWithResources & cache, const fheroes2::Rect & roiScreen )
+    void DrawWorld( const ViewWorld::ZoomROIs & ROI, const CacheForMapWithResources & cache, const fheroes2::Rect & roiScreen )
     {
         fheroes2::Display & display = fheroes2::Display::instance();
         const uint8_t zoomLevelId = static_cast<uint8_t>( ROI.getZoomLevel() );
-        const fheroes2::Image & image = cache.cachedImages[zoomLevelId];
+        const fheroes2::Image & image = cache.getImages()[zoomLevelId];
 
         const int32_t offsetPixelsX = tileSizePerZoomLevel[zoomLevelId] * ROI.GetROIinPixels().x / fheroes2::tileWidthPx;
         const int32_t offsetPixelsY = tileSizePerZoomLevel[zoomLevelId] * ROI.GetROIinPixels().y / fheroes2::tileWidthPx;
@@ -327,9 +503,11 @@ namespace
         const int32_t worldHeight = world.h();
         assert( worldWidth >= 0 && worldHeight >= 0 );
 
+        std::vector<fheroes2::Image> & images = cache.getImagesForIcons();
+
         // Render two flags to the left and to the right of Castle/Town entrance.
-        const auto renderCastleFlags = [&cache]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
-            for ( size_t zoomLevelId = 0; zoomLevelId < cache.getZoomLevels(); ++zoomLevelId ) {
+        const auto renderCastleFlags = [&images]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
+            for ( size_t zoomLevelId = 0; zoomLevelId < images.size(); ++zoomLevelId ) {
                 const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
 
                 const int32_t icnFlagsBase = icnPerZoomLevelFlags[zoomLevelId];
@@ -339,26 +517,26 @@ namespace
                 const int32_t dstx = posX * tileSize + ( tileSize - sprite.width() ) / 2;
                 const int32_t dsty = posY * tileSize + ( tileSize - sprite.height() ) / 2 + 1;
 
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx + tileSize, dsty, false );
+                fheroes2::Blit( sprite, images[zoomLevelId], dstx + tileSize, dsty, false );
                 // We place a second flag, flipped horizontally.
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - tileSize, dsty, true );
+                fheroes2::Blit( sprite, images[zoomLevelId], dstx - tileSize, dsty, true );
             }
         };
 
         // Render hero/artifact icon.
-        const auto renderIcon = [&cache]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
-            for ( size_t zoomLevelId = 0; zoomLevelId < cache.getZoomLevels(); ++zoomLevelId ) {
+        const auto renderIcon = [&images]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
+            for ( size_t zoomLevelId = 0; zoomLevelId < images.size(); ++zoomLevelId ) {
                 const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
                 const int32_t dstx = posX * tileSize + tileSize / 2;
                 const int32_t dsty = posY * tileSize + tileSize / 2;
 
                 const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
+                fheroes2::Blit( sprite, images[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
             }
         };
 
         // Render resource/mine icon with letter inside.
-        const auto renderResourceIcon = [&cache]( const uint32_t icnIndex, const uint32_t resource, const int32_t posX, const int32_t posY ) {
+        const auto renderResourceIcon = [&images]( const uint32_t icnIndex, const uint32_t resource, const int32_t posX, const int32_t posY ) {
             const uint32_t letterIndex = resourceToOffsetICN( resource );
 
             if ( letterIndex == unknownIndex ) {
@@ -366,15 +544,15 @@ namespace
                 return;
             }
 
-            for ( size_t zoomLevelId = 0; zoomLevelId < cache.getZoomLevels(); ++zoomLevelId ) {
+            for ( size_t zoomLevelId = 0; zoomLevelId < images.size(); ++zoomLevelId ) {
                 const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
                 const int32_t dstx = posX * tileSize + tileSize / 2;
                 const int32_t dsty = posY * tileSize + tileSize / 2;
 
                 const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
+                fheroes2::Blit( sprite, images[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
                 const fheroes2::Sprite & letter = fheroes2::AGG::GetICN( icnLetterPerZoomLevel[zoomLevelId], letterIndex );
-                fheroes2::Blit( letter, cache.cachedImages[zoomLevelId], dstx - letter.width() / 2, dsty - letter.height() / 2 );
+                fheroes2::Blit( letter, images[zoomLevelId], dstx - letter.width() / 2, dsty - letter.height() / 2 );
             }
         };
 
@@ -586,6 +764,11 @@ fheroes2::Rect ViewWorld::ZoomROIs::GetROIinTiles() const
     return result;
 }
 
+void ViewWorld::resetCache()
+{
+    worldMapImageCache.reset();
+}
+
 void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mode, Interface::BaseInterface & interface )
 {
     fheroes2::Display & display = fheroes2::Display::instance();
@@ -52,6 +52,9 @@ class ViewWorld
 public:
     static void ViewWorldWindow( const PlayerColor color, const ViewWorldMode mode, Interface::BaseInterface & interface );
 
+    // Frees the world map images which are kept between openings of the View World window.
+    static void resetCache();
+
     class ZoomROIs
     {
     public:
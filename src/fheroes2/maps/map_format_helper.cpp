@@ -917,6 +917,39 @@ namespace
 
 namespace Maps
 {
+    bool createEmptyMap( Map_Format::MapFormat & map, const int32_t mapWidth )
+    {
+        if ( mapWidth <= 0 ) {
+            return false;
+        }
+
+        map = {};
+
+        world.generateUninitializedMap( mapWidth );
+
+        if ( world.w() != mapWidth || world.h() != mapWidth ) {
+            assert( 0 );
+
+            return false;
+        }
+
+        map.width = mapWidth;
+
+        // Only square maps are supported so map height is the same as width.
+        const int32_t tilesCount = mapWidth * mapWidth;
+
+        map.tiles.resize( tilesCount );
+
+        for ( int32_t i = 0; i < tilesCount; ++i ) {
+            world.getTile( i ).setIndex( i );
+            setTerrainOnTile( map, i, Ground::WATER );
+        }
+
+        resetObjectUID();
+
+        return true;
+    }
+
     bool readMapInEditor( const Map_Format::MapFormat & map )
     {
         world.generateUninitializedMap( map.width );
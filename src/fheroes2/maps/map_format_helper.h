@@ -52,6 +52,9 @@ namespace Maps
 
     enum class ObjectGroup : uint8_t;
 
+    // Resets both the map and the world to a square map of the given width fully covered with water.
+    bool createEmptyMap( Map_Format::MapFormat & map, const int32_t mapWidth );
+
     bool readMapInEditor( const Map_Format::MapFormat & map );
     bool readAllTiles( const Map_Format::MapFormat & map );
 
@@ -850,4 +850,31 @@ namespace Maps::Map_Format
     {
         return loadFromStream( stream, map );
     }
+
+    bool saveMapWithoutTiles( OStreamBase & stream, const MapFormat & map )
+    {
+        if ( !saveToStream( stream, static_cast<const BaseMapFormat &>( map ) ) ) {
+            return false;
+        }
+
+        stream << map.additionalInfo << map.dailyEvents << map.rumors << map.castleMetadata << map.heroMetadata << map.sphinxMetadata << map.signMetadata
+               << map.adventureMapEventMetadata << map.selectionObjectMetadata << map.capturableObjectsMetadata << map.monsterMetadata << map.artifactMetadata
+               << map.resourceMetadata << map.translationInfo;
+
+        return !stream.fail();
+    }
+
+    bool loadMapWithoutTiles( IStreamBase & stream, MapFormat & map )
+    {
+        // The data is always written by the current version of the engine so no conversion is needed.
+        if ( !loadFromStream( stream, static_cast<BaseMapFormat &>( map ) ) || map.version != currentSupportedVersion ) {
+            return false;
+        }
+
+        stream >> map.additionalInfo >> map.dailyEvents >> map.rumors >> map.castleMetadata >> map.heroMetadata >> map.sphinxMetadata >> map.signMetadata
+            >> map.adventureMapEventMetadata >> map.selectionObjectMetadata >> map.capturableObjectsMetadata >> map.monsterMetadata >> map.artifactMetadata
+            >> map.resourceMetadata >> map.translationInfo;
+
+        return !stream.fail();
+    }
 }
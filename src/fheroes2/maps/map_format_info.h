@@ -46,6 +46,16 @@ namespace Maps::Map_Format
         ObjectGroup group{ ObjectGroup::NONE };
 
         uint32_t index{ 0 };
+
+        bool operator==( const TileObjectInfo & anotherObject ) const
+        {
+            return id == anotherObject.id && group == anotherObject.group && index == anotherObject.index;
+        }
+
+        bool operator!=( const TileObjectInfo & anotherObject ) const
+        {
+            return !( *this == anotherObject );
+        }
     };
 
     struct TileInfo
@@ -54,6 +64,16 @@ namespace Maps::Map_Format
         uint8_t terrainFlags{ 0 };
 
         std::vector<TileObjectInfo> objects;
+
+        bool operator==( const TileInfo & anotherTile ) const
+        {
+            return terrainIndex == anotherTile.terrainIndex && terrainFlags == anotherTile.terrainFlags && objects == anotherTile.objects;
+        }
+
+        bool operator!=( const TileInfo & anotherTile ) const
+        {
+            return !( *this == anotherTile );
+        }
     };
 
     constexpr size_t messageCharLimit{ 999 };
@@ -428,4 +448,9 @@ namespace Maps::Map_Format
 
     bool saveMap( OStreamBase & stream, const MapFormat & map );
     bool loadMap( IStreamBase & stream, MapFormat & map );
+
+    // Save and load everything except tiles without compression. These functions are used by the Editor to keep
+    // the history of changes where tiles are stored separately. The data is not meant to be stored in files.
+    bool saveMapWithoutTiles( OStreamBase & stream, const MapFormat & map );
+    bool loadMapWithoutTiles( IStreamBase & stream, MapFormat & map );
 }
@@ -36,7 +36,6 @@
 
 #include "color.h"
 #include "direction.h"
-#include "editor_interface.h"
 #include "ground.h"
 #include "logging.h"
 #include "map_format_helper.h"
@@ -618,7 +617,7 @@ namespace Maps::Random_Generator
         return std::max<int32_t>( 0, waterTiles * 100 / tileCount );
     }
 
-    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height )
+    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height, MapStatistics * statistics )
     {
         // Make sure that we are generating a valid map.
         assert( width > 0 && height > 0 );
@@ -629,8 +628,10 @@ namespace Maps::Random_Generator
         }
 
         // Initialization step. Reset the current map in `world` and `mapFormat` containers first.
-        Interface::EditorInterface & interface = Interface::EditorInterface::Get();
-        if ( !interface.generateNewMap( width ) ) {
+        // Only square maps are supported.
+        assert( width == height );
+
+        if ( !Maps::createEmptyMap( mapFormat, width ) ) {
             return false;
         }
 
@@ -977,6 +978,23 @@ namespace Maps::Random_Generator
                                 + layoutToString( config.mapLayout ) + " layout, " + resourceDensityToString( config.resourceDensity ) + " resource density and "
                                 + monsterStrengthToString( config.monsterStrength ) + " monster strength.";
 
+        if ( statistics != nullptr ) {
+            *statistics = {};
+
+            for ( const Region & region : mapRegions ) {
+                if ( region.id == 0 ) {
+                    continue;
+                }
+
+                ++statistics->regionCount;
+
+                if ( region.type == RegionType::STARTING ) {
+                    statistics->startingRegionSizes.push_back( static_cast<int32_t>( region.nodes.size() ) );
+                    statistics->startingRegionConnections.push_back( static_cast<int32_t>( region.connections.size() ) );
+                }
+            }
+        }
+
         return true;
     }
 }
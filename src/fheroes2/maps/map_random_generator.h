@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Maps::Map_Format
 {
@@ -68,9 +69,21 @@ namespace Maps::Random_Generator
         MonsterStrength monsterStrength{ MonsterStrength::NORMAL };
     };
 
+    // Information about the regions of a generated map which is used to evaluate how balanced the map is.
+    struct MapStatistics final
+    {
+        // The number of tiles and the number of connections to other regions of each starting region, in the order of players.
+        std::vector<int32_t> startingRegionSizes;
+        std::vector<int32_t> startingRegionConnections;
+
+        // The number of regions excluding water and map edges.
+        int32_t regionCount{ 0 };
+    };
+
     std::string layoutToString( const Layout layout );
     std::string resourceDensityToString( const ResourceDensity resources );
     std::string monsterStrengthToString( const MonsterStrength monsters );
     int32_t calculateMaximumWaterPercentage( const int32_t playerCount, const int32_t mapWidth );
-    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height );
+    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height,
+                      MapStatistics * statistics = nullptr );
 }
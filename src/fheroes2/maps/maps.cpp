@@ -28,6 +28,8 @@
 #include <cmath>
 #include <cstdlib>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <ostream>
 
 #include "ai_planner.h"
@@ -61,13 +63,42 @@ namespace
 
     Maps::Indexes MapsIndexesObject( const MP2::MapObjectType objectType, const bool ignoreHeroes )
     {
-        Maps::Indexes result;
-        const int32_t size = static_cast<int32_t>( world.getSize() );
-        for ( int32_t idx = 0; idx < size; ++idx ) {
-            if ( world.getTile( idx ).getMainObjectType( !ignoreHeroes ) == objectType ) {
-                result.push_back( idx );
+        if ( objectType == MP2::OBJ_NONE ) {
+            // Empty tiles are not indexed.
+            Maps::Indexes result;
+            const int32_t size = static_cast<int32_t>( world.getSize() );
+            for ( int32_t idx = 0; idx < size; ++idx ) {
+                if ( world.getTile( idx ).getMainObjectType( !ignoreHeroes ) == objectType ) {
+                    result.push_back( idx );
+                }
+            }
+            return result;
+        }
+
+        if ( !ignoreHeroes ) {
+            return world.getTilesWithObjectType( objectType );
+        }
+
+        // Objects under heroes are indexed as OBJ_HERO so the tiles with heroes have to be checked separately.
+        Maps::Indexes objectsUnderHeroes;
+        for ( const int32_t idx : world.getTilesWithObjectType( MP2::OBJ_HERO ) ) {
+            if ( world.getTile( idx ).getMainObjectType( false ) == objectType ) {
+                objectsUnderHeroes.push_back( idx );
             }
         }
+
+        if ( objectType == MP2::OBJ_HERO ) {
+            return objectsUnderHeroes;
+        }
+
+        const Maps::Indexes & objects = world.getTilesWithObjectType( objectType );
+        if ( objectsUnderHeroes.empty() ) {
+            return objects;
+        }
+
+        Maps::Indexes result;
+        result.reserve( objects.size() + objectsUnderHeroes.size() );
+        std::merge( objects.begin(), objects.end(), objectsUnderHeroes.begin(), objectsUnderHeroes.end(), std::back_inserter( result ) );
         return result;
     }
 
@@ -94,6 +125,41 @@ namespace
         return squaredDistanceLimit;
     }
 
+    // Returns the half-width of the scouting area in the row located 'dy' rows away from its center or -1 if the row is outside this area.
+    int32_t getScoutingRowHalfWidth( const int32_t scoutingDistance, const int32_t squaredScoutingRadiusLimit, const int32_t dy )
+    {
+        int32_t halfWidth = scoutingDistance;
+        while ( halfWidth >= 0 && halfWidth * halfWidth + dy * dy >= squaredScoutingRadiusLimit ) {
+            --halfWidth;
+        }
+
+        return halfWidth;
+    }
+
+    // Returns the bits of the fog row word 'wordId' which correspond to tiles in the [fromX, toX] range.
+    uint64_t getFogRowMask( const int32_t fromX, const int32_t toX, const size_t wordId )
+    {
+        const int32_t wordMinX = static_cast<int32_t>( wordId * 64 );
+        const int32_t firstBit = std::max( fromX - wordMinX, 0 );
+        const int32_t lastBit = std::min( toX - wordMinX, 63 );
+        if ( firstBit > lastBit ) {
+            return 0;
+        }
+
+        const uint64_t upToLastBit = ( lastBit == 63 ) ? ~static_cast<uint64_t>( 0 ) : ( static_cast<uint64_t>( 1 ) << ( lastBit + 1 ) ) - 1;
+        return upToLastBit & ~( ( static_cast<uint64_t>( 1 ) << firstBit ) - 1 );
+    }
+
+    int32_t countBits( uint64_t value )
+    {
+        int32_t count = 0;
+        for ( ; value != 0; value &= value - 1 ) {
+            ++count;
+        }
+
+        return count;
+    }
+
     void forEachMonsterProtectingTile( const int32_t tileIndex, const std::function<void( const int32_t )> & lambda )
     {
         const int width = world.w();
@@ -486,14 +552,42 @@ void Maps::ClearFog( const int32_t tileIndex, const int32_t scoutingDistance, co
     fheroes2::Point fogRevealMinPos( world.h(), worldWidth );
     fheroes2::Point fogRevealMaxPos( 0, 0 );
 
+    // Tiles without fog are skipped using the fog bitplanes, 64 tiles at a time.
+    std::vector<uint64_t> alliedFogRow;
+    std::vector<uint64_t> playerFogRow;
+
     for ( int32_t y = minY; y <= maxY; ++y ) {
-        const int32_t dy = y - center.y;
-        const int32_t dySquared = dy * dy;
+        const int32_t halfWidth = getScoutingRowHalfWidth( scoutingDistance, squaredScoutingRadiusLimit, y - center.y );
+        if ( halfWidth < 0 ) {
+            continue;
+        }
+
+        const int32_t fromX = std::max( center.x - halfWidth, minX );
+        const int32_t toX = std::min( center.x + halfWidth, maxX );
         const int32_t offset = y * worldWidth;
 
-        for ( int32_t x = minX; x <= maxX; ++x ) {
-            const int32_t dx = x - center.x;
-            if ( dx * dx + dySquared < squaredScoutingRadiusLimit ) {
+        world.getFogRow( y, alliedColors, alliedFogRow );
+        if ( isAIPlayer ) {
+            world.getFogRow( y, static_cast<PlayerColorsSet>( playerColor ), playerFogRow );
+        }
+
+        for ( size_t wordId = static_cast<size_t>( fromX ) / 64; wordId <= static_cast<size_t>( toX ) / 64; ++wordId ) {
+            uint64_t fogTiles = alliedFogRow[wordId];
+            if ( isAIPlayer ) {
+                fogTiles |= playerFogRow[wordId];
+            }
+
+            if ( ( fogTiles & getFogRowMask( fromX, toX, wordId ) ) == 0 ) {
+                continue;
+            }
+
+            const int32_t wordMinX = static_cast<int32_t>( wordId * 64 );
+
+            for ( int32_t x = std::max( fromX, wordMinX ); x <= std::min( toX, wordMinX + 63 ); ++x ) {
+                if ( ( ( fogTiles >> ( x - wordMinX ) ) & 1 ) == 0 ) {
+                    continue;
+                }
+
                 Maps::Tile & tile = world.getTile( x + offset );
                 if ( isAIPlayer && tile.isFog( playerColor ) ) {
                     AI::Planner::Get().revealFog( tile, kingdom );
@@ -544,19 +638,21 @@ int32_t Maps::getFogTileCountToBeRevealed( const int32_t tileIndex, const int32_
 
     int32_t tileCount = 0;
 
+    std::vector<uint64_t> fogRow;
+
     for ( int32_t y = minY; y <= maxY; ++y ) {
-        const int32_t dy = y - center.y;
-        const int32_t dySquared = dy * dy;
-        const int32_t offset = y * worldWidth;
+        const int32_t halfWidth = getScoutingRowHalfWidth( scoutingDistance, squaredScoutingRadiusLimit, y - center.y );
+        if ( halfWidth < 0 ) {
+            continue;
+        }
 
-        for ( int32_t x = minX; x <= maxX; ++x ) {
-            const int32_t dx = x - center.x;
-            if ( dx * dx + dySquared < squaredScoutingRadiusLimit ) {
-                const Maps::Tile & tile = world.getTile( x + offset );
-                if ( tile.isFog( playerColor ) ) {
-                    ++tileCount;
-                }
-            }
+        const int32_t fromX = std::max( center.x - halfWidth, minX );
+        const int32_t toX = std::min( center.x + halfWidth, maxX );
+
+        world.getFogRow( y, static_cast<PlayerColorsSet>( playerColor ), fogRow );
+
+        for ( size_t wordId = static_cast<size_t>( fromX ) / 64; wordId <= static_cast<size_t>( toX ) / 64; ++wordId ) {
+            tileCount += countBits( fogRow[wordId] & getFogRowMask( fromX, toX, wordId ) );
         }
     }
 
@@ -589,21 +685,39 @@ Maps::Indexes Maps::ScanAroundObject( const int32_t center, const MP2::MapObject
 
 Maps::Indexes Maps::ScanAroundObjectWithDistance( const int32_t center, const uint32_t dist, const MP2::MapObjectType objectType )
 {
-    Indexes results = getAroundIndexes( center, dist );
+    const size_t areaSideSize = static_cast<size_t>( dist ) * 2 + 1;
+    const size_t candidateCount
+        = ( objectType == MP2::OBJ_NONE ) ? std::numeric_limits<size_t>::max() : world.getTilesWithObjectType( objectType ).size() + world.getTilesWithObjectType( MP2::OBJ_HERO ).size();
+
+    if ( candidateCount >= areaSideSize * areaSideSize || !isValidAbsIndex( center ) ) {
+        // It is cheaper to check every tile in the area than to go through all objects of this type on the map.
+        Indexes results = getAroundIndexes( center, dist );
+        std::sort( results.begin(), results.end(), ComparisonDistance( center ) );
+        return MapsIndexesFilteredObject( results, objectType );
+    }
+
+    const fheroes2::Point centerPoint = GetPoint( center );
+    const int32_t maxDistance = static_cast<int32_t>( dist );
+
+    Indexes results = MapsIndexesObject( objectType, true );
+    results.erase( std::remove_if( results.begin(), results.end(),
+                                   [center, &centerPoint, maxDistance]( const int32_t index ) {
+                                       const fheroes2::Point point = GetPoint( index );
+                                       return index == center || std::abs( point.x - centerPoint.x ) > maxDistance || std::abs( point.y - centerPoint.y ) > maxDistance;
+                                   } ),
+                   results.end() );
+
     std::sort( results.begin(), results.end(), ComparisonDistance( center ) );
-    return MapsIndexesFilteredObject( results, objectType );
+    return results;
 }
 
 bool Maps::doesObjectExistOnMap( const MP2::MapObjectType objectType )
 {
-    const int32_t size = static_cast<int32_t>( world.getSize() );
-    for ( int32_t idx = 0; idx < size; ++idx ) {
-        if ( world.getTile( idx ).getMainObjectType( false ) == objectType ) {
-            return true;
-        }
+    if ( objectType != MP2::OBJ_NONE && objectType != MP2::OBJ_HERO && !world.getTilesWithObjectType( objectType ).empty() ) {
+        return true;
     }
 
-    return false;
+    return !MapsIndexesObject( objectType, true ).empty();
 }
 
 Maps::Indexes Maps::GetObjectPositions( const MP2::MapObjectType objectType )
@@ -639,8 +753,9 @@ bool Maps::isTileUnderProtection( const int32_t tileIndex )
 
 bool Maps::isTileProtectionStrongerThan( const int32_t tileIndex, const double armyStrength )
 {
-    // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-    static Army tileArmy;
+    // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations. This function can be
+    // called by pathfinders evaluated in parallel, so each thread needs its own instance.
+    thread_local Army tileArmy;
     bool isStronger = false;
 
     forEachMonsterProtectingTile( tileIndex, [&armyStrength, &isStronger]( const int32_t monsterIndex ) {
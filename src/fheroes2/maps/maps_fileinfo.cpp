@@ -30,9 +30,12 @@
 #include <initializer_list>
 #include <list>
 #include <map>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "color.h"
 #include "difficulty.h"
@@ -51,6 +54,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "tools.h"
 #include "ui_font.h"
 #include "ui_language.h"
@@ -60,6 +64,264 @@ namespace
     const size_t mapNameLength = 16;
     const size_t mapDescriptionLength = 200;
 
+    enum class MapFileKind : uint8_t
+    {
+        ORIGINAL, // .mp2 and .mx2 files
+        RESURRECTION_FOR_GAME,
+        RESURRECTION_FOR_EDITOR
+    };
+
+    // Sets the version of the current save file for the lifetime of the object and then restores the original one, since this
+    // version affects the way all save data is read.
+    class SaveFileVersionRestorer
+    {
+    public:
+        explicit SaveFileVersionRestorer( const uint16_t version )
+            : _originalVersion( Game::GetVersionOfCurrentSaveFile() )
+        {
+            Game::SetVersionOfCurrentSaveFile( version );
+        }
+
+        SaveFileVersionRestorer( const SaveFileVersionRestorer & ) = delete;
+
+        ~SaveFileVersionRestorer()
+        {
+            Game::SetVersionOfCurrentSaveFile( _originalVersion );
+        }
+
+        SaveFileVersionRestorer & operator=( const SaveFileVersionRestorer & ) = delete;
+
+    private:
+        const uint16_t _originalVersion;
+    };
+
+    // The cache of the information about map files which is kept on disk between runs of the game. The information
+    // is stored along with the size and the modification time of the file, so only new or modified files are parsed.
+    class MapFileInfoCache
+    {
+    public:
+        // Returns the information about every given map file, or an empty value if the file is not a valid map.
+        std::vector<std::optional<Maps::FileInfo>> readMapFiles( const ListFiles & mapFiles, const MapFileKind kind, const fheroes2::SupportedLanguage language )
+        {
+            if ( !_isLoaded ) {
+                _isLoaded = true;
+
+                _load();
+            }
+
+            std::vector<std::optional<Maps::FileInfo>> result( mapFiles.size() );
+
+            std::vector<std::pair<size_t, const std::string *>> filesToParse;
+            std::vector<Entry> parsedEntries;
+
+            std::set<std::string, std::less<>> existingFiles;
+
+            size_t fileId = 0;
+            for ( const std::string & mapFile : mapFiles ) {
+                Entry entry;
+                entry.language = language;
+
+                if ( !System::GetFileSizeAndModificationTime( mapFile, entry.fileSize, entry.modificationTime ) ) {
+                    // The file is not accessible.
+                    ++fileId;
+                    continue;
+                }
+
+                existingFiles.emplace( mapFile );
+
+                const auto iter = _entries.find( { mapFile, kind } );
+                if ( iter != _entries.end() && _isEntryUpToDate( iter->second, entry, kind ) ) {
+                    if ( iter->second.isValid ) {
+                        result[fileId] = iter->second.info;
+                        result[fileId]->filename = mapFile;
+                    }
+                }
+                else {
+                    filesToParse.emplace_back( fileId, &mapFile );
+                    parsedEntries.emplace_back( std::move( entry ) );
+                }
+
+                ++fileId;
+            }
+
+            // Map files are independent of each other, so they are parsed in parallel.
+            MultiThreading::executeInParallel( filesToParse.size(), [&filesToParse, &parsedEntries, kind, language]( const size_t id ) {
+                Entry & entry = parsedEntries[id];
+
+                if ( kind == MapFileKind::ORIGINAL ) {
+                    entry.isValid = entry.info.readMP2Map( *filesToParse[id].second, false );
+                }
+                else {
+                    entry.isValid = entry.info.readResurrectionMap( *filesToParse[id].second, kind == MapFileKind::RESURRECTION_FOR_EDITOR, language );
+                }
+            } );
+
+            bool isChanged = !filesToParse.empty();
+
+            for ( size_t id = 0; id < filesToParse.size(); ++id ) {
+                const auto & [resultId, mapFile] = filesToParse[id];
+                Entry & entry = parsedEntries[id];
+
+                if ( entry.isValid ) {
+                    result[resultId] = entry.info;
+                }
+
+                _entries[{ *mapFile, kind }] = std::move( entry );
+            }
+
+            // Forget about the files of the same kind which do not exist anymore.
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ) {
+                if ( iter->first.second == kind && existingFiles.count( iter->first.first ) == 0 ) {
+                    iter = _entries.erase( iter );
+                    isChanged = true;
+                }
+                else {
+                    ++iter;
+                }
+            }
+
+            if ( isChanged ) {
+                _save();
+            }
+
+            return result;
+        }
+
+    private:
+        using CacheKey = std::pair<std::string, MapFileKind>;
+
+        struct Entry
+        {
+            uint64_t fileSize{ 0 };
+            int64_t modificationTime{ 0 };
+
+            // The name and the description of Resurrection maps depend on the language which was used while reading them.
+            fheroes2::SupportedLanguage language{ fheroes2::SupportedLanguage::English };
+
+            // Files which are not valid maps are also cached, so that they are not parsed again.
+            bool isValid{ false };
+
+            Maps::FileInfo info;
+        };
+
+        // Must be changed whenever the layout of the cache file changes.
+        static constexpr uint16_t _cacheFormatVersion{ 1 };
+
+        static std::string _getCacheFilePath()
+        {
+            return System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "maps.cache" );
+        }
+
+        static bool _isEntryUpToDate( const Entry & cachedEntry, const Entry & entry, const MapFileKind kind )
+        {
+            if ( cachedEntry.fileSize != entry.fileSize || cachedEntry.modificationTime != entry.modificationTime ) {
+                return false;
+            }
+
+            return kind != MapFileKind::RESURRECTION_FOR_GAME || cachedEntry.language == entry.language;
+        }
+
+        void _load()
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( _getCacheFilePath(), "rb" ) ) {
+                return;
+            }
+
+            uint16_t cacheFormatVersion = 0;
+            uint16_t saveFormatVersion = 0;
+            std::string gameVersion;
+
+            fileStream >> cacheFormatVersion >> saveFormatVersion >> gameVersion;
+
+            // The way map files are parsed could have changed in another version of the game, so the cache has to be rebuilt.
+            if ( fileStream.fail() || cacheFormatVersion != _cacheFormatVersion || saveFormatVersion != CURRENT_FORMAT_VERSION || gameVersion != Settings::GetVersion() ) {
+                return;
+            }
+
+            // Map information is stored in the format of the current save files.
+            const SaveFileVersionRestorer saveFileVersionRestorer( CURRENT_FORMAT_VERSION );
+
+            uint32_t entryCount = 0;
+            fileStream >> entryCount;
+
+            std::map<CacheKey, Entry> entries;
+
+            for ( uint32_t i = 0; i < entryCount; ++i ) {
+                std::string mapFile;
+                MapFileKind kind = MapFileKind::ORIGINAL;
+                Entry entry;
+                uint32_t fileSizeHigh = 0;
+                uint32_t fileSizeLow = 0;
+                uint32_t modificationTimeHigh = 0;
+                uint32_t modificationTimeLow = 0;
+
+                // Streams do not support 64-bit values so they are stored as two 32-bit halves.
+                fileStream >> mapFile >> kind >> fileSizeHigh >> fileSizeLow >> modificationTimeHigh >> modificationTimeLow >> entry.language >> entry.isValid;
+
+                entry.fileSize = ( static_cast<uint64_t>( fileSizeHigh ) << 32 ) | fileSizeLow;
+                entry.modificationTime = static_cast<int64_t>( ( static_cast<uint64_t>( modificationTimeHigh ) << 32 ) | modificationTimeLow );
+
+                if ( entry.isValid ) {
+                    fileStream >> entry.info;
+                }
+
+                if ( fileStream.fail() ) {
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "The map information cache file is corrupted." )
+                    return;
+                }
+
+                entries.try_emplace( { std::move( mapFile ), kind }, std::move( entry ) );
+            }
+
+            _entries = std::move( entries );
+        }
+
+        void _save() const
+        {
+            const std::string cacheFilePath = _getCacheFilePath();
+            const std::string cacheDirectory = System::GetParentDirectory( cacheFilePath );
+
+            if ( !System::IsDirectory( cacheDirectory ) && !System::MakeDirectory( cacheDirectory ) ) {
+                return;
+            }
+
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            if ( !fileStream.open( cacheFilePath, "wb" ) ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Unable to write the map information cache file " << cacheFilePath )
+                return;
+            }
+
+            fileStream << _cacheFormatVersion << CURRENT_FORMAT_VERSION << Settings::GetVersion() << static_cast<uint32_t>( _entries.size() );
+
+            for ( const auto & [key, entry] : _entries ) {
+                const uint64_t modificationTime = static_cast<uint64_t>( entry.modificationTime );
+
+                fileStream << key.first << key.second << static_cast<uint32_t>( entry.fileSize >> 32 ) << static_cast<uint32_t>( entry.fileSize )
+                           << static_cast<uint32_t>( modificationTime >> 32 ) << static_cast<uint32_t>( modificationTime ) << entry.language << entry.isValid;
+
+                if ( entry.isValid ) {
+                    fileStream << entry.info;
+                }
+            }
+        }
+
+        std::map<CacheKey, Entry> _entries;
+
+        bool _isLoaded{ false };
+    };
+
+    std::vector<std::optional<Maps::FileInfo>> readMapFiles( const ListFiles & mapFiles, const MapFileKind kind, const fheroes2::SupportedLanguage language )
+    {
+        static MapFileInfoCache cache;
+
+        return cache.readMapFiles( mapFiles, kind, language );
+    }
+
     // This function returns an unsorted array. It is a caller responsibility to take care of sorting if needed.
     MapsFileInfoList getValidMaps( const ListFiles & mapFiles, const uint8_t humanPlayerCount, const bool isOriginalMapFormat )
     {
@@ -78,20 +340,14 @@ namespace
             = isOriginalMapFormat
               && ( fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French && fheroes2::getResourceLanguage() == fheroes2::SupportedLanguage::French );
 
-        for ( const std::string & mapFile : mapFiles ) {
-            Maps::FileInfo fi;
-
-            if ( isOriginalMapFormat ) {
-                if ( !fi.readMP2Map( mapFile, false ) ) {
-                    continue;
-                }
-            }
-            else {
-                if ( !fi.readResurrectionMap( mapFile, false, currentLanguage ) ) {
-                    continue;
-                }
+        for ( std::optional<Maps::FileInfo> & mapInfo :
+              readMapFiles( mapFiles, isOriginalMapFormat ? MapFileKind::ORIGINAL : MapFileKind::RESURRECTION_FOR_GAME, currentLanguage ) ) {
+            if ( !mapInfo ) {
+                continue;
             }
 
+            Maps::FileInfo & fi = *mapInfo;
+
             const int humanOnlyColorsCount = Color::Count( fi.HumanOnlyColors() );
             if ( humanOnlyColorsCount > humanPlayerCount ) {
                 // This map requires more human-only players than needed.
@@ -772,14 +1028,13 @@ MapsFileInfoList Maps::getEditorMapFileInfos()
     std::multimap<std::string, Maps::FileInfo, std::less<>> sortedMaps;
     const auto currentLanguage = fheroes2::getCurrentLanguage();
 
-    for ( const std::string & mapFile : maps ) {
-        Maps::FileInfo fi;
-
-        if ( !fi.readResurrectionMap( mapFile, true, currentLanguage ) ) {
+    for ( std::optional<Maps::FileInfo> & mapInfo : readMapFiles( maps, MapFileKind::RESURRECTION_FOR_EDITOR, currentLanguage ) ) {
+        if ( !mapInfo ) {
             continue;
         }
 
-        sortedMaps.emplace( StringLower( System::GetFileName( mapFile ) ), std::move( fi ) );
+        std::string fileName = StringLower( System::GetFileName( mapInfo->filename ) );
+        sortedMaps.emplace( std::move( fileName ), std::move( *mapInfo ) );
     }
 
     if ( sortedMaps.empty() ) {
@@ -476,16 +476,26 @@ MP2::MapObjectType Maps::Tile::_getMainObjectTypeUnderHero() const
 
 void Maps::Tile::setMainObjectType( const MP2::MapObjectType objectType )
 {
+    // Temporary tiles (for example, the ones created while reading the headers of map files, possibly in parallel) are not a part
+    // of the world, so they must not affect its caches.
+    const bool isWorldTile = world.isWorldTile( *this );
+
+    if ( isWorldTile ) {
+        world.updateTileObjectType( _index, _mainObjectType, objectType );
+    }
+
     _mainObjectType = objectType;
 
-    world.resetPathfinder();
+    if ( isWorldTile ) {
+        world.markTileChangedForPathfinders( _index );
+    }
 }
 
 void Maps::Tile::setBoat( const int direction, const PlayerColor color )
 {
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
         // It is important to preserve the order of objects for rendering purposes. Therefore, the main object should go to the front of objects.
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.insert( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // If this assertion blows up then you are trying to put a boat on land!
@@ -839,11 +849,11 @@ void Maps::Tile::sortObjectParts()
 
     // Push everything to the container and sort it by level.
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.insert( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // Sort by internal layers.
-    _groundObjectPart.sort( []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
+    std::stable_sort( _groundObjectPart.begin(), _groundObjectPart.end(), []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
 
     if ( !_groundObjectPart.empty() ) {
         auto highestPriorityPartIter = _groundObjectPart.end();
@@ -1284,8 +1294,8 @@ void Maps::Tile::updateFlag( const PlayerColor color, const uint8_t objectSprite
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == PlayerColor::NONE ) {
         const auto isFlag = [uid]( const auto & part ) { return part._uid == uid && part.icnType == MP2::OBJ_ICN_TYPE_FLAG32; };
-        _groundObjectPart.remove_if( isFlag );
-        _topObjectPart.remove_if( isFlag );
+        _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isFlag ), _groundObjectPart.end() );
+        _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isFlag ), _topObjectPart.end() );
         return;
     }
 
@@ -1452,13 +1462,15 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
     bool isObjectPartRemoved = false;
 
     size_t partCountBefore = _groundObjectPart.size();
-    _groundObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), [objectUID]( const auto & v ) { return v._uid == objectUID; } ),
+                             _groundObjectPart.end() );
     if ( partCountBefore != _groundObjectPart.size() ) {
         isObjectPartRemoved = true;
     }
 
     partCountBefore = _topObjectPart.size();
-    _topObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), [objectUID]( const auto & v ) { return v._uid == objectUID; } ),
+                          _topObjectPart.end() );
     if ( partCountBefore != _topObjectPart.size() ) {
         isObjectPartRemoved = true;
     }
@@ -1510,8 +1522,9 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
 
 void Maps::Tile::removeObjects( const MP2::ObjectIcnType objectIcnType )
 {
-    _groundObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
-    _topObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
+    const auto isObjectIcnType = [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; };
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isObjectIcnType ), _groundObjectPart.end() );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isObjectIcnType ), _topObjectPart.end() );
 
     if ( _mainObjectPart.icnType == objectIcnType ) {
         _mainObjectPart = {};
@@ -1575,12 +1588,18 @@ void Maps::Tile::updateObjectImageIndex( const uint32_t objectUid, const MP2::Ob
 
 void Maps::Tile::ClearFog( const PlayerColorsSet colors )
 {
+    if ( ( _fogColors & colors ) == 0 ) {
+        return;
+    }
+
     _fogColors &= ~colors;
 
+    world.updateTileFog( _index, _fogColors );
+
     // The fog might be cleared even without the hero's movement - for example, the hero can gain a new level of Scouting
     // skill by picking up a Treasure Chest from a nearby tile or buying a map in a Magellan's Maps object using the space
-    // bar button. Reset the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
-    world.resetPathfinder();
+    // bar button. Update the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
+    world.markTileChangedForPathfinders( _index );
 }
 
 void Maps::Tile::updateTileObjectIcnIndex( Maps::Tile & tile, const uint32_t uid, const uint8_t newIndex )
@@ -2108,7 +2108,7 @@ namespace Maps
         assert( ( minPos.x <= maxPos.x ) && ( minPos.y <= maxPos.y ) );
 
         const int32_t worldWidth = world.w();
-        const int32_t worldHeight = world.w();
+        const int32_t worldHeight = world.h();
 
         // Do not get over the world borders.
         const int32_t minX = std::max<int32_t>( minPos.x, 0 );
@@ -2117,117 +2117,97 @@ namespace Maps
         const int32_t maxX = std::min<int32_t>( maxPos.x + 1, worldWidth );
         const int32_t maxY = std::min<int32_t>( maxPos.y + 1, worldHeight );
 
-        // Fog data range is 1 tile bigger from each side as for the fog directions we have to check all tiles around each tile in the area.
-        const int32_t fogMinX = std::max<int32_t>( minX - 1, 0 );
-        const int32_t fogMinY = std::max<int32_t>( minY - 1, 0 );
-        const int32_t fogMaxX = std::min<int32_t>( maxX + 1, worldWidth );
-        const int32_t fogMaxY = std::min<int32_t>( maxY + 1, worldHeight );
-
-        const int32_t fogDataWidth = maxX - minX + 2;
-        const int32_t fogDataSize = fogDataWidth * ( maxY - minY + 2 );
+        if ( minX >= maxX || minY >= maxY ) {
+            return;
+        }
 
-        // A vector to cache 'isFog()' data. This vector type is not <bool> as using std::vector<uint8_t> gives the higher performance.
-        // 1 is for the 'true' state, 0 is for the 'false' state.
-        std::vector<uint8_t> fogData( fogDataSize, 1 );
+        const size_t wordCount = world.getFogRowWordCount();
 
-        // Set the 'fogData' index offset from the tile index.
-        const int32_t fogDataOffset = 1 - minX + ( 1 - minY ) * fogDataWidth;
+        // The fog of 3 rows around the current one. Tiles outside the map are considered to be under the fog.
+        std::vector<uint64_t> topRow;
+        std::vector<uint64_t> centerRow;
+        std::vector<uint64_t> bottomRow;
 
-        // Cache the 'fogData' data for the given area to use it in fog direction calculation.
-        // The loops run only within the world area, if 'fogData' area includes tiles outside the world borders we do not update them as the are already set to 1.
-        for ( int32_t y = fogMinY; y < fogMaxY; ++y ) {
-            const int32_t fogTileOffsetY = y * worldWidth;
-            const int32_t fogDataOffsetY = y * fogDataWidth + fogDataOffset;
+        world.getFogRow( minY - 1, colors, topRow );
+        world.getFogRow( minY, colors, centerRow );
 
-            for ( int32_t x = fogMinX; x < fogMaxX; ++x ) {
-                fogData[x + fogDataOffsetY] = world.getTile( x + fogTileOffsetY ).isFog( colors ) ? 1 : 0;
-            }
-        }
+        // Returns a word where bit 'x' is the fog of tile 'x - 1' of the row.
+        const auto getLeftNeighbours = []( const std::vector<uint64_t> & row, const size_t wordId ) {
+            return ( row[wordId] << 1 ) | ( wordId > 0 ? row[wordId - 1] >> 63 : 1 );
+        };
 
-        // Set the 'fogData' index offset from the tile index for the TOP LEFT direction from the tile.
-        const int32_t topLeftDirectionOffset = -1 - fogDataWidth;
+        // Returns a word where bit 'x' is the fog of tile 'x + 1' of the row.
+        const auto getRightNeighbours = [wordCount]( const std::vector<uint64_t> & row, const size_t wordId ) {
+            return ( row[wordId] >> 1 ) | ( ( wordId + 1 < wordCount ? row[wordId + 1] : 1 ) << 63 );
+        };
 
-#ifndef NDEBUG
-        // Cache the maximum border for fogDataIndex corresponding the "CENTER" tile to use in assertion. Should be removed if assertion is removed.
-        const int32_t centerfogDataIndexLimit = fogDataSize + topLeftDirectionOffset;
-#endif
+        const size_t minWordId = static_cast<size_t>( minX ) / 64;
+        const size_t maxWordId = static_cast<size_t>( maxX - 1 ) / 64;
 
-        // Calculate fog directions using the cached 'isFog' data.
         for ( int32_t y = minY; y < maxY; ++y ) {
-            const int32_t fogCenterDataOffsetY = y * fogDataWidth + fogDataOffset;
-
-            for ( int32_t x = minX; x < maxX; ++x ) {
-                Tile & tile = world.getTile( x, y );
-
-                int32_t fogDataIndex = x + fogCenterDataOffsetY;
+            world.getFogRow( y + 1, colors, bottomRow );
+
+            for ( size_t wordId = minWordId; wordId <= maxWordId; ++wordId ) {
+                // All 8 neighbours of 64 tiles are computed at once.
+                const uint64_t center = centerRow[wordId];
+                const uint64_t topLeft = getLeftNeighbours( topRow, wordId );
+                const uint64_t top = topRow[wordId];
+                const uint64_t topRight = getRightNeighbours( topRow, wordId );
+                const uint64_t left = getLeftNeighbours( centerRow, wordId );
+                const uint64_t right = getRightNeighbours( centerRow, wordId );
+                const uint64_t bottomLeft = getLeftNeighbours( bottomRow, wordId );
+                const uint64_t bottom = bottomRow[wordId];
+                const uint64_t bottomRight = getRightNeighbours( bottomRow, wordId );
+
+                const int32_t wordMinX = static_cast<int32_t>( wordId * 64 );
+                const int32_t fromX = std::max( minX, wordMinX );
+                const int32_t toX = std::min( maxX, wordMinX + 64 );
+
+                for ( int32_t x = fromX; x < toX; ++x ) {
+                    Tile & tile = world.getTile( x, y );
+
+                    const uint64_t tileBit = static_cast<uint64_t>( 1 ) << ( x - wordMinX );
+
+                    if ( ( center & tileBit ) == 0 ) {
+                        // For the tile is without fog we set the UNKNOWN direction.
+                        tile.setFogDirection( Direction::UNKNOWN );
+                        continue;
+                    }
 
-                if ( fogData[fogDataIndex] == 0 ) {
-                    // For the tile is without fog we set the UNKNOWN direction.
-                    tile.setFogDirection( Direction::UNKNOWN );
-                }
-                else {
                     // The tile is under the fog so its CENTER direction for fog is true.
                     uint16_t fogDirection = Direction::CENTER;
 
-                    // 'fogDataIndex' should not get out of maximum 'fogData' vector index after all increments.
-                    assert( fogDataIndex < centerfogDataIndexLimit );
-
-                    // Check all tiles around for 'fogData' starting from the top left direction and if it is true then logically add the direction to 'fogDirection'.
-                    fogDataIndex += topLeftDirectionOffset;
-
-                    assert( fogDataIndex >= 0 );
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( topLeft & tileBit ) {
                         fogDirection |= Direction::TOP_LEFT;
                     }
-
-                    ++fogDataIndex;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( top & tileBit ) {
                         fogDirection |= Direction::TOP;
                     }
-
-                    ++fogDataIndex;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( topRight & tileBit ) {
                         fogDirection |= Direction::TOP_RIGHT;
                     }
-
-                    // Set index to the left direction tile of the next fog data raw.
-                    fogDataIndex += fogDataWidth - 2;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( left & tileBit ) {
                         fogDirection |= Direction::LEFT;
                     }
-
-                    // Skip the center tile as it was already checked.
-                    fogDataIndex += 2;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( right & tileBit ) {
                         fogDirection |= Direction::RIGHT;
                     }
-
-                    fogDataIndex += fogDataWidth - 2;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( bottomLeft & tileBit ) {
                         fogDirection |= Direction::BOTTOM_LEFT;
                     }
-
-                    ++fogDataIndex;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( bottom & tileBit ) {
                         fogDirection |= Direction::BOTTOM;
                     }
-
-                    ++fogDataIndex;
-
-                    if ( fogData[fogDataIndex] == 1 ) {
+                    if ( bottomRight & tileBit ) {
                         fogDirection |= Direction::BOTTOM_RIGHT;
                     }
 
                     tile.setFogDirection( fogDirection );
                 }
             }
+
+            std::swap( topRow, centerRow );
+            std::swap( centerRow, bottomRow );
         }
     }
 
@@ -26,6 +26,8 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <optional>
 #include <ostream>
@@ -62,11 +64,15 @@
 #include "tools.h"
 #include "translations.h"
 #include "ui_font.h"
+#include "view_world.h"
 #include "week.h"
 #include "world_object_uid.h"
 
 namespace
 {
+    // One fog bitplane for every bit of a set of player colors.
+    constexpr size_t fogBitplaneCount = sizeof( PlayerColorsSet ) * 8;
+
     bool isTileBlockedForSettingMonster( const int32_t tileId, const int32_t radius, const std::set<int32_t> & excludeTiles )
     {
         const MapsIndexes & indexes = Maps::getAroundIndexes( tileId, radius );
@@ -302,6 +308,8 @@ void World::Reset()
 
     // maps tiles
     vec_tiles.clear();
+    _tilesByObjectType.clear();
+    _fogBitplanes.clear();
 
     // kingdoms
     vec_kingdoms.clear();
@@ -332,6 +340,8 @@ void World::Reset()
     heroIdAsLossCondition = Heroes::UNKNOWN;
 
     _seed = 0;
+
+    ViewWorld::resetCache();
 }
 
 void World::generateBattleOnlyMap( const int32_t groundType )
@@ -1196,8 +1206,151 @@ void World::resetPathfinder()
     AI::Planner::Get().resetPathfinder();
 }
 
+void World::markTileChangedForPathfinders( const int32_t tileIndex )
+{
+    _pathfinder.markTileChanged( tileIndex );
+    AI::Planner::Get().markPathfinderTileChanged( tileIndex );
+}
+
+const MapsIndexes & World::getTilesWithObjectType( const MP2::MapObjectType objectType ) const
+{
+    assert( objectType != MP2::OBJ_NONE );
+
+    // The index must be built by PostLoad() before any object lookups.
+    assert( !_tilesByObjectType.empty() );
+
+    if ( objectType >= _tilesByObjectType.size() ) {
+        static const MapsIndexes noTiles;
+        return noTiles;
+    }
+
+    return _tilesByObjectType[objectType];
+}
+
+void World::getFogRow( const int32_t y, const PlayerColorsSet colors, std::vector<uint64_t> & row ) const
+{
+    const size_t wordCount = getFogRowWordCount();
+
+    row.assign( wordCount, ~static_cast<uint64_t>( 0 ) );
+
+    if ( y < 0 || y >= height ) {
+        return;
+    }
+
+    const size_t planeSize = wordCount * static_cast<size_t>( height );
+
+    if ( _fogBitplanes.empty() && !vec_tiles.empty() ) {
+        // Tiles are under the fog by default as well as the area outside the map.
+        _fogBitplanes.assign( planeSize * fogBitplaneCount, ~static_cast<uint64_t>( 0 ) );
+
+        for ( const Maps::Tile & tile : vec_tiles ) {
+            const int32_t tileIndex = tile.GetIndex();
+            const size_t wordOffset = static_cast<size_t>( tileIndex / width ) * wordCount + static_cast<size_t>( tileIndex % width ) / 64;
+            const uint64_t tileBit = static_cast<uint64_t>( 1 ) << ( tileIndex % width % 64 );
+
+            for ( size_t plane = 0; plane < fogBitplaneCount; ++plane ) {
+                if ( !tile.isFog( static_cast<PlayerColorsSet>( 1 << plane ) ) ) {
+                    _fogBitplanes[plane * planeSize + wordOffset] &= ~tileBit;
+                }
+            }
+        }
+    }
+
+    if ( _fogBitplanes.empty() ) {
+        return;
+    }
+
+    for ( size_t plane = 0; plane < fogBitplaneCount; ++plane ) {
+        if ( ( colors & ( 1 << plane ) ) == 0 ) {
+            continue;
+        }
+
+        const uint64_t * planeRow = _fogBitplanes.data() + plane * planeSize + static_cast<size_t>( y ) * wordCount;
+        for ( size_t i = 0; i < wordCount; ++i ) {
+            row[i] &= planeRow[i];
+        }
+    }
+}
+
+void World::updateTileFog( const int32_t tileIndex, const PlayerColorsSet fogColors )
+{
+    if ( _fogBitplanes.empty() ) {
+        // Bitplanes will be built from the actual tiles on the first request.
+        return;
+    }
+
+    const size_t wordCount = getFogRowWordCount();
+    const size_t planeSize = wordCount * static_cast<size_t>( height );
+    const size_t wordOffset = static_cast<size_t>( tileIndex / width ) * wordCount + static_cast<size_t>( tileIndex % width ) / 64;
+    const uint64_t tileBit = static_cast<uint64_t>( 1 ) << ( tileIndex % width % 64 );
+
+    for ( size_t plane = 0; plane < fogBitplaneCount; ++plane ) {
+        uint64_t & word = _fogBitplanes[plane * planeSize + wordOffset];
+        if ( fogColors & ( 1 << plane ) ) {
+            word |= tileBit;
+        }
+        else {
+            word &= ~tileBit;
+        }
+    }
+}
+
+void World::updateTileObjectType( const int32_t tileIndex, const MP2::MapObjectType oldObjectType, const MP2::MapObjectType newObjectType )
+{
+    if ( _tilesByObjectType.empty() || oldObjectType == newObjectType ) {
+        // The index has not been built yet, it will be built from the actual tiles once the map is loaded.
+        return;
+    }
+
+    if ( oldObjectType != MP2::OBJ_NONE ) {
+        assert( oldObjectType < _tilesByObjectType.size() );
+
+        MapsIndexes & tiles = _tilesByObjectType[oldObjectType];
+        const auto iter = std::lower_bound( tiles.begin(), tiles.end(), tileIndex );
+        assert( iter != tiles.end() && *iter == tileIndex );
+
+        tiles.erase( iter );
+    }
+
+    if ( newObjectType != MP2::OBJ_NONE ) {
+        if ( newObjectType >= _tilesByObjectType.size() ) {
+            _tilesByObjectType.resize( newObjectType + 1 );
+        }
+
+        MapsIndexes & tiles = _tilesByObjectType[newObjectType];
+        tiles.insert( std::lower_bound( tiles.begin(), tiles.end(), tileIndex ), tileIndex );
+    }
+}
+
+void World::buildTileObjectTypeIndex()
+{
+    _tilesByObjectType.clear();
+    _tilesByObjectType.resize( MP2::OBJ_HERO + 1 );
+
+    // Tiles are visited in ascending order so every list is sorted right away.
+    for ( const Maps::Tile & tile : vec_tiles ) {
+        const MP2::MapObjectType tileObjectType = tile.getMainObjectType();
+        if ( tileObjectType == MP2::OBJ_NONE ) {
+            continue;
+        }
+
+        if ( tileObjectType >= _tilesByObjectType.size() ) {
+            _tilesByObjectType.resize( tileObjectType + 1 );
+        }
+
+        _tilesByObjectType[tileObjectType].push_back( tile.GetIndex() );
+    }
+}
+
 void World::updatePassabilities()
 {
+    std::vector<uint16_t> oldPassabilities;
+    oldPassabilities.reserve( vec_tiles.size() );
+
+    for ( const Maps::Tile & tile : vec_tiles ) {
+        oldPassabilities.push_back( tile.GetPassable() );
+    }
+
     for ( Maps::Tile & tile : vec_tiles ) {
         // If tile is empty then update tile's object type if needed.
         if ( tile.getMainObjectType() == MP2::OBJ_NONE ) {
@@ -1211,10 +1364,19 @@ void World::updatePassabilities()
     for ( Maps::Tile & tile : vec_tiles ) {
         tile.updatePassability();
     }
+
+    for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
+        if ( vec_tiles[i].GetPassable() != oldPassabilities[i] ) {
+            markTileChangedForPathfinders( static_cast<int32_t>( i ) );
+        }
+    }
 }
 
 void World::PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum )
 {
+    // All object lookups below and during the game rely on this index.
+    buildTileObjectTypeIndex();
+
     if ( setTilePassabilities ) {
         updatePassabilities();
     }
@@ -1488,7 +1650,18 @@ IStreamBase & operator>>( IStreamBase & stream, World & w )
         stream >> w.width >> w.height;
     }
 
-    stream >> w.vec_tiles >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w._ultimateArtifact >> w._day
+    // Tiles are replaced as a whole so the fog bitplanes have to be rebuilt.
+    w._fogBitplanes.clear();
+
+    // The world map images of another game are of no use anymore.
+    ViewWorld::resetCache();
+
+    stream >> w.vec_tiles;
+
+    // Tiles are replaced as a whole so the index of their object types has to be rebuilt before any of them is modified below.
+    w.buildTileObjectTypeIndex();
+
+    stream >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w._ultimateArtifact >> w._day
         >> w._week >> w._month >> w.heroIdAsWinCondition >> w.heroIdAsLossCondition;
 
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
@@ -251,6 +251,14 @@ public:
 #endif
     }
 
+    // Returns true if the tile is stored in the world, as opposed to temporary tiles which are not a part of any map.
+    bool isWorldTile( const Maps::Tile & tile ) const
+    {
+        const int32_t tileIndex = tile.GetIndex();
+
+        return tileIndex >= 0 && static_cast<size_t>( tileIndex ) < vec_tiles.size() && &vec_tiles[tileIndex] == &tile;
+    }
+
     const Maps::Tile & getTile( const int32_t tileId ) const
     {
 #ifdef WITH_DEBUG
@@ -499,6 +507,29 @@ public:
     std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
     void resetPathfinder();
 
+    // Informs the pathfinders that the tile has changed, so that they can update only the affected parts of their caches
+    void markTileChangedForPathfinders( const int32_t tileIndex );
+
+    // Returns the indexes, in ascending order, of all tiles whose main object type is the given one. Tiles occupied by heroes are
+    // stored as OBJ_HERO. OBJ_NONE is not indexed. Must not be called before the map is loaded.
+    const MapsIndexes & getTilesWithObjectType( const MP2::MapObjectType objectType ) const;
+
+    // Keeps the index of tiles by main object type up to date. Must be called whenever the main object type of a tile changes.
+    void updateTileObjectType( const int32_t tileIndex, const MP2::MapObjectType oldObjectType, const MP2::MapObjectType newObjectType );
+
+    // Returns the number of 64-bit words used to store the fog of a single map row.
+    size_t getFogRowWordCount() const
+    {
+        return ( static_cast<size_t>( width ) + 63 ) / 64;
+    }
+
+    // Fills the row with the fog of the map row 'y', where bit 'x % 64' of word 'x / 64' is set if the tile is under the fog
+    // for all given colors. Bits of tiles outside the map are always set.
+    void getFogRow( const int32_t y, const PlayerColorsSet colors, std::vector<uint64_t> & row ) const;
+
+    // Keeps the fog bitplanes up to date. Must be called whenever the fog of a tile changes.
+    void updateTileFog( const int32_t tileIndex, const PlayerColorsSet fogColors );
+
     void ComputeStaticAnalysis();
 
     uint32_t GetMapSeed() const
@@ -534,6 +565,9 @@ private:
 
     void PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum );
 
+    // Builds the index of tiles by main object type from scratch. Must be called every time the tiles are replaced as a whole.
+    void buildTileObjectTypeIndex();
+
     bool updateTileMetadata( Maps::Tile & tile, const MP2::MapObjectType objectType, const bool checkPoLObjects );
 
     bool isValidCastleEntrance( const fheroes2::Point & tilePosition ) const;
@@ -580,6 +614,14 @@ private:
     std::map<uint8_t, Maps::Indexes> _allWhirlpools; // All indexes of tiles that contain a certain part (sprite index) of the whirlpool
     std::vector<int32_t> _allEyeOfMagi;
 
+    // Indexes of tiles for every main object type, built by buildTileObjectTypeIndex() and then maintained by updateTileObjectType().
+    // An empty container means that the index has not been built yet.
+    std::vector<MapsIndexes> _tilesByObjectType;
+
+    // The fog of tiles as one bitplane per player color, built on the first request and then maintained by updateTileFog().
+    // Every bitplane consists of map rows of getFogRowWordCount() words. An empty container means that bitplanes have not been built yet.
+    mutable std::vector<uint64_t> _fogBitplanes;
+
     uint8_t _waterPercentage{ 0 };
     double _landRoughness{ 1.0 };
     std::vector<MapRegion> _regions;
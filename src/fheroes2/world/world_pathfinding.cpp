@@ -25,6 +25,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -38,6 +39,7 @@
 #include "ground.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "logging.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
@@ -49,6 +51,7 @@
 #include "route.h"
 #include "spell.h"
 #include "spell_info.h"
+#include "timing.h"
 #include "tools.h"
 #include "world.h"
 
@@ -79,8 +82,9 @@ namespace
         const MP2::MapObjectType objectType = tile.getMainObjectType();
 
         const auto isTileAccessible = [color, armyStrength, minimalAdvantage, &tile]() {
-            // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-            static Army tileArmy;
+            // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations. Pathfinders
+            // of different heroes can be evaluated in parallel, so each thread needs its own instance.
+            thread_local Army tileArmy;
             tileArmy.setFromTile( tile );
 
             const PlayerColor tileArmyColor = tileArmy.GetColor();
@@ -319,13 +323,236 @@ namespace
         // This movement takes place on the same turn
         return movePoints - subtractedMovePoints;
     }
+
+    // The initial number of buckets should be enough to cover the most expensive regular moves (including the additional penalties
+    // applied by the AI pathfinder), so that the node queue rarely needs to grow. Must be a power of two.
+    const size_t initialNodeQueueBucketCount = 1024;
+}
+
+void WorldNodeCache::resize( const size_t size )
+{
+    const size_t wordCount = ( size + bitsPerWord - 1 ) / bitsPerWord;
+
+    _from.resize( size );
+    _cost.resize( size );
+    _remainingMovePoints.resize( size );
+
+    for ( std::vector<uint64_t> & words : _isAICheckEvaluated ) {
+        words.resize( wordCount );
+    }
+
+    for ( std::vector<uint64_t> & words : _aiCheckResult ) {
+        words.resize( wordCount );
+    }
+
+    clear();
+}
+
+void WorldNodeCache::clear()
+{
+    // Unlike an array of node structures, these arrays can be reset using memset(), which is much faster, given that this
+    // has to be done before each full evaluation of the pathfinder cache. All bits set represent -1 for the "from" array.
+    if ( _from.empty() ) {
+        return;
+    }
+
+    memset( _from.data(), 0xFF, _from.size() * sizeof( int32_t ) );
+    memset( _cost.data(), 0, _cost.size() * sizeof( uint32_t ) );
+    memset( _remainingMovePoints.data(), 0, _remainingMovePoints.size() * sizeof( uint32_t ) );
+
+    // There is no need to reset the results of the AI checks themselves, they are ignored until they are evaluated again
+    for ( std::vector<uint64_t> & words : _isAICheckEvaluated ) {
+        memset( words.data(), 0, words.size() * sizeof( uint64_t ) );
+    }
+}
+
+void WorldNodeCache::swap( WorldNodeCache & other ) noexcept
+{
+    std::swap( _from, other._from );
+    std::swap( _cost, other._cost );
+    std::swap( _remainingMovePoints, other._remainingMovePoints );
+    std::swap( _isAICheckEvaluated, other._isAICheckEvaluated );
+    std::swap( _aiCheckResult, other._aiCheckResult );
+}
+
+void WorldNodeQueue::reset( const size_t worldSize )
+{
+    if ( _buckets.empty() ) {
+        _buckets.resize( initialNodeQueueBucketCount );
+    }
+
+    restart( 0 );
+
+    _isExpanded.assign( worldSize, 0 );
+    _expandedNodesCount = 0;
+}
+
+void WorldNodeQueue::push( const int nodeIdx, const uint32_t cost )
+{
+    assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < _isExpanded.size() );
+
+    if ( _isReferenceMode ) {
+        // All nodes are kept in the first bucket in the order in which they were added, regardless of their cost
+        _buckets.front().push_back( nodeIdx );
+
+        ++_size;
+
+        return;
+    }
+
+    // The queue is monotone: it is impossible to add a node that is cheaper than the node that is currently being processed
+    assert( cost >= _currentCost );
+
+    if ( cost - _currentCost >= _buckets.size() ) {
+        grow( cost );
+    }
+
+    _buckets[cost & ( _buckets.size() - 1 )].push_back( nodeIdx );
+    _isExpanded[nodeIdx] = 0;
+
+    ++_size;
+}
+
+bool WorldNodeQueue::pop( int & nodeIdx )
+{
+    if ( _isReferenceMode ) {
+        if ( _size == 0 ) {
+            return false;
+        }
+
+        std::vector<int> & bucket = _buckets.front();
+        assert( _currentBucketPos < bucket.size() );
+
+        nodeIdx = bucket[_currentBucketPos];
+
+        ++_currentBucketPos;
+        --_size;
+
+        // Nodes are never considered as expanded in this mode, so they are processed again every time their cost is reduced
+        ++_expandedNodesCount;
+
+        return true;
+    }
+
+    return popNext( nodeIdx, UINT32_MAX );
+}
+
+bool WorldNodeQueue::pop( int & nodeIdx, const uint32_t maxCost )
+{
+    // Partial processing relies on the information about expanded nodes
+    assert( !_isReferenceMode );
+
+    if ( popNext( nodeIdx, maxCost ) ) {
+        return true;
+    }
+
+    // If the queue is empty, then move on to the given maximum cost right away
+    if ( _size == 0 && _currentCost < maxCost ) {
+        restart( maxCost );
+    }
+
+    return false;
+}
+
+void WorldNodeQueue::restart( const uint32_t cost )
+{
+    for ( std::vector<int> & bucket : _buckets ) {
+        bucket.clear();
+    }
+
+    _currentCost = cost;
+    _currentBucketPos = 0;
+    _size = 0;
+}
+
+void WorldNodeQueue::grow( const uint32_t cost )
+{
+    assert( !_buckets.empty() && cost >= _currentCost );
+
+    size_t newBucketCount = _buckets.size();
+    while ( cost - _currentCost >= newBucketCount ) {
+        newBucketCount *= 2;
+    }
+
+    std::vector<std::vector<int>> buckets( newBucketCount );
+
+    const size_t oldMask = _buckets.size() - 1;
+    const size_t newMask = newBucketCount - 1;
+
+    // All the nodes in the queue have costs in the range [_currentCost, _currentCost + _buckets.size())
+    for ( size_t i = 0; i < _buckets.size(); ++i ) {
+        const size_t bucketCost = _currentCost + i;
+
+        std::vector<int> & bucket = _buckets[bucketCost & oldMask];
+        const size_t firstPos = ( i == 0 ) ? _currentBucketPos : 0;
+
+        if ( firstPos < bucket.size() ) {
+            buckets[bucketCost & newMask].assign( bucket.begin() + static_cast<std::ptrdiff_t>( firstPos ), bucket.end() );
+        }
+    }
+
+    _buckets = std::move( buckets );
+    _currentBucketPos = 0;
+}
+
+void WorldNodeQueue::swap( WorldNodeQueue & other ) noexcept
+{
+    std::swap( _buckets, other._buckets );
+    std::swap( _isExpanded, other._isExpanded );
+    std::swap( _currentCost, other._currentCost );
+    std::swap( _currentBucketPos, other._currentBucketPos );
+    std::swap( _size, other._size );
+    std::swap( _expandedNodesCount, other._expandedNodesCount );
+    std::swap( _isReferenceMode, other._isReferenceMode );
+}
+
+bool WorldNodeQueue::popNext( int & nodeIdx, const uint32_t maxCost )
+{
+    const size_t mask = _buckets.size() - 1;
+
+    while ( _size > 0 ) {
+        std::vector<int> & bucket = _buckets[_currentCost & mask];
+
+        if ( _currentBucketPos == bucket.size() ) {
+            // Nodes with the maximum cost can still be added to the queue, so stay on the current bucket
+            if ( _currentCost >= maxCost ) {
+                return false;
+            }
+
+            bucket.clear();
+
+            _currentBucketPos = 0;
+            ++_currentCost;
+
+            continue;
+        }
+
+        const int idx = bucket[_currentBucketPos];
+
+        ++_currentBucketPos;
+        --_size;
+
+        // This node was already expanded with a lower (or the same) cost
+        if ( _isExpanded[idx] != 0 ) {
+            continue;
+        }
+
+        _isExpanded[idx] = 1;
+        ++_expandedNodesCount;
+
+        nodeIdx = idx;
+
+        return true;
+    }
+
+    return false;
 }
 
 uint32_t WorldPathfinder::getDistance( int targetIndex ) const
 {
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
 
-    return _cache[targetIndex]._cost;
+    return _cache.getCost( targetIndex );
 }
 
 uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, const int direction ) const
@@ -345,12 +572,10 @@ uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, cons
     // tile (both in straight and diagonal direction) as long as we have enough movement points
     // to move over our current tile in the straight direction
     if ( getMaxMovePoints( fromTile.isWater() ) > 0 ) {
-        const WorldNode & node = _cache[from];
-
         // No dead ends allowed
-        assert( from == _pathStart || node._from != -1 );
+        assert( from == _pathStart || _cache.getFrom( from ) != -1 );
 
-        const uint32_t remainingMovePoints = node._remainingMovePoints;
+        const uint32_t remainingMovePoints = _cache.getRemainingMovePoints( from );
         const uint32_t fromTilePenalty = fromTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, _pathfindingSkill );
 
         // If we still have enough movement points to move over the source tile in the straight
@@ -385,30 +610,244 @@ void WorldPathfinder::reset()
     _color = PlayerColor::NONE;
     _remainingMovePoints = 0;
     _pathfindingSkill = Skill::Level::EXPERT;
+
+    _changedTiles.clear();
+}
+
+void WorldPathfinder::swapState( WorldPathfinder & other ) noexcept
+{
+    _cache.swap( other._cache );
+    std::swap( _mapOffset, other._mapOffset );
+    _nodesToExplore.swap( other._nodesToExplore );
+    std::swap( _changedTiles, other._changedTiles );
+    std::swap( _pathStart, other._pathStart );
+    std::swap( _color, other._color );
+    std::swap( _remainingMovePoints, other._remainingMovePoints );
+    std::swap( _pathfindingSkill, other._pathfindingSkill );
+}
+
+void WorldPathfinder::markTileChanged( const int32_t tileIndex )
+{
+    // The cache is not valid anyway, it will be re-evaluated from scratch
+    if ( _pathStart == -1 ) {
+        return;
+    }
+
+    assert( Maps::isValidAbsIndex( tileIndex ) );
+
+    // If too many tiles have changed, then it is cheaper to re-evaluate the entire cache
+    if ( _changedTiles.size() >= _cache.size() / 8 ) {
+        reset();
+
+        return;
+    }
+
+    _changedTiles.push_back( tileIndex );
 }
 
 void WorldPathfinder::processWorldMap()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
+    _changedTiles.clear();
+
+    _cache.clear();
+    _cache.update( _pathStart, -1, 0, _remainingMovePoints );
+
+    _nodesToExplore.reset( _cache.size() );
+    _nodesToExplore.push( _pathStart, 0 );
+
+    exploreNodes();
+}
+
+void WorldPathfinder::exploreNodes()
+{
+#ifdef WITH_DEBUG
+    const fheroes2::Time timer;
+#endif
+
+    int currentNodeIdx = -1;
+
+    while ( _nodesToExplore.pop( currentNodeIdx ) ) {
+        processCurrentNode( currentNodeIdx );
+    }
+
+    DEBUG_LOG( DBG_GAME, DBG_TRACE,
+               "start tile: " << _pathStart << ", expanded nodes: " << _nodesToExplore.getExpandedNodesCount() << ", time: " << timer.getS() * 1000 << " ms" )
+}
+
+void WorldPathfinder::processChangedTiles()
+{
+    assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
+
+    // The reference exploration does not keep track of expanded nodes, so the cache can only be evaluated from scratch
+    if ( _nodesToExplore.isReferenceMode() ) {
+        processWorldMap();
+
+        return;
+    }
+
+    enum class NodeState : uint8_t
+    {
+        UNKNOWN,
+        VALID,
+        INVALID,
+        SOURCE
+    };
+
+    const auto & directions = Direction::allNeighboringDirections;
+    const int32_t worldSize = static_cast<int32_t>( _cache.size() );
+
+    std::vector<NodeState> nodeStates( _cache.size(), NodeState::UNKNOWN );
+
+    // Changes on a tile can affect the passability of the neighboring tiles, as well as their protection by monsters
+    for ( const int32_t tileIdx : _changedTiles ) {
+        nodeStates[tileIdx] = NodeState::INVALID;
+
+        for ( size_t i = 0; i < directions.size(); ++i ) {
+            if ( Maps::isValidDirection( tileIdx, directions[i] ) ) {
+                nodeStates[tileIdx + _mapOffset[i]] = NodeState::INVALID;
+            }
+        }
+    }
+
+#ifdef WITH_DEBUG
+    const size_t changedTilesCount = _changedTiles.size();
+#endif
+
+    _changedTiles.clear();
+
+    if ( nodeStates[_pathStart] == NodeState::INVALID ) {
+        processWorldMap();
+
+        return;
+    }
+
+    nodeStates[_pathStart] = NodeState::VALID;
+
+    // All nodes of the shortest path tree whose path passes through the affected tiles are no longer valid
+    size_t invalidNodesCount = 0;
+
+    {
+        std::vector<int32_t> nodesOnPath;
+
+        for ( int32_t nodeIdx = 0; nodeIdx < worldSize; ++nodeIdx ) {
+            int32_t currentNodeIdx = nodeIdx;
+
+            while ( nodeStates[currentNodeIdx] == NodeState::UNKNOWN ) {
+                const int from = _cache.getFrom( currentNodeIdx );
+
+                // This node was either unreachable or rejected, and nothing has changed around it
+                if ( from == -1 ) {
+                    nodeStates[currentNodeIdx] = NodeState::VALID;
+                    break;
+                }
+
+                nodesOnPath.push_back( currentNodeIdx );
+
+                currentNodeIdx = from;
+            }
+
+            const NodeState state = nodeStates[currentNodeIdx];
+
+            for ( const int32_t idx : nodesOnPath ) {
+                nodeStates[idx] = state;
+            }
+
+            nodesOnPath.clear();
+
+            if ( nodeStates[nodeIdx] == NodeState::INVALID ) {
+                ++invalidNodesCount;
+            }
+        }
+    }
+
+    // Most of the cache should be re-evaluated anyway
+    if ( invalidNodesCount > _cache.size() / 2 ) {
+        processWorldMap();
+
+        return;
+    }
+
+    // Reset the invalid nodes and find the valid nodes from which they can be reached again
+    std::vector<std::pair<uint32_t, int>> sources;
+
+    {
+        std::vector<int> nonAdjacentSources;
+
+        const auto addSource = [this, &nodeStates, &sources]( const int sourceIdx ) {
+            if ( nodeStates[sourceIdx] != NodeState::VALID || !_nodesToExplore.isExpanded( sourceIdx ) ) {
+                return;
+            }
+
+            // Skip the rejected nodes
+            if ( sourceIdx != _pathStart && _cache.getFrom( sourceIdx ) == -1 ) {
+                return;
+            }
+
+            nodeStates[sourceIdx] = NodeState::SOURCE;
+            sources.emplace_back( _cache.getCost( sourceIdx ), sourceIdx );
+        };
+
+        for ( int32_t nodeIdx = 0; nodeIdx < worldSize; ++nodeIdx ) {
+            if ( nodeStates[nodeIdx] != NodeState::INVALID ) {
+                continue;
+            }
+
+            _cache.resetNode( nodeIdx );
+            _nodesToExplore.markAsNotExpanded( nodeIdx );
+
+            for ( size_t i = 0; i < directions.size(); ++i ) {
+                if ( Maps::isValidDirection( nodeIdx, directions[i] ) ) {
+                    addSource( nodeIdx + _mapOffset[i] );
+                }
+            }
+
+            nonAdjacentSources.clear();
+            appendNonAdjacentSources( nodeIdx, nonAdjacentSources );
+
+            for ( const int sourceIdx : nonAdjacentSources ) {
+                addSource( sourceIdx );
+            }
+        }
     }
 
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
+    DEBUG_LOG( DBG_GAME, DBG_TRACE,
+               "start tile: " << _pathStart << ", changed tiles: " << changedTilesCount << ", invalid nodes: " << invalidNodesCount << ", sources: " << sources.size() )
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    if ( sources.empty() ) {
+        return;
+    }
+
+    // Re-process the source nodes in ascending order of their cost along with the newly reached nodes, as Dijkstra's algorithm
+    // would do. Valid nodes can be expanded again if they can be reached in a cheaper way now.
+    std::sort( sources.begin(), sources.end() );
+
+    _nodesToExplore.restart( sources.front().first );
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+    for ( const auto & [sourceCost, sourceIdx] : sources ) {
+        int currentNodeIdx = -1;
+
+        while ( _nodesToExplore.pop( currentNodeIdx, sourceCost ) ) {
+            processCurrentNode( currentNodeIdx );
+        }
+
+        // This node has been reached in a cheaper way and is already queued for expansion
+        if ( !_nodesToExplore.isExpanded( sourceIdx ) ) {
+            continue;
+        }
+
+        processCurrentNode( sourceIdx );
     }
+
+    exploreNodes();
 }
 
-void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void WorldPathfinder::checkAdjacentNodes( const int currentNodeIdx )
 {
     const auto & directions = Direction::allNeighboringDirections;
-    const WorldNode & currentNode = _cache[currentNodeIdx];
+    const uint32_t currentNodeCost = _cache.getCost( currentNodeIdx );
+    const uint32_t currentNodeRemainingMovePoints = _cache.getRemainingMovePoints( currentNodeIdx );
     const uint32_t maxMovePoints = getMaxMovePoints( world.getTile( currentNodeIdx ).isWater() );
 
     for ( size_t i = 0; i < directions.size(); ++i ) {
@@ -422,14 +861,16 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, con
         }
 
         const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, newIndex, directions[i] );
-        const uint32_t movementCost = currentNode._cost + movementPenalty;
+        const uint32_t movementCost = currentNodeCost + movementPenalty;
 
-        WorldNode & newNode = _cache[newIndex];
+        if ( isNodeFinal( newIndex, movementCost ) ) {
+            continue;
+        }
 
-        if ( newNode._from == -1 || newNode._cost > movementCost ) {
-            newNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
+        if ( _cache.getFrom( newIndex ) == -1 || _cache.getCost( newIndex ) > movementCost ) {
+            _cache.update( newIndex, currentNodeIdx, movementCost, subtractMovePoints( currentNodeRemainingMovePoints, movementPenalty, maxMovePoints ) );
 
-            nodesToExplore.push_back( newIndex );
+            _nodesToExplore.push( newIndex, movementCost );
         }
     }
 }
@@ -457,6 +898,9 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
 
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        processChangedTiles();
+    }
 }
 
 std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
@@ -466,7 +910,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     std::list<Route::Step> path;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( _cache.getCost( targetIndex ) == 0 ) {
         return path;
     }
 
@@ -479,27 +923,26 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     while ( currentNode != _pathStart ) {
         assert( currentNode != -1 );
 
-        const WorldNode & node = _cache[currentNode];
+        const int from = _cache.getFrom( currentNode );
 
-        assert( node._from != -1 );
+        assert( from != -1 );
 
-        const uint32_t cost = node._cost - _cache[node._from]._cost;
+        const uint32_t cost = _cache.getCost( currentNode ) - _cache.getCost( from );
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_front( currentNode, from, Maps::GetDirection( from, currentNode ), cost );
 
         // The path should not pass through the same tile more than once
-        assert( uniqPathIndexes.insert( node._from ).second );
+        assert( uniqPathIndexes.insert( from ).second );
 
-        currentNode = node._from;
+        currentNode = from;
     }
 
     return path;
 }
 
-void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void PlayerWorldPathfinder::processCurrentNode( const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
-    const WorldNode & currentNode = _cache[currentNodeIdx];
     const bool fromWater = world.getTile( _pathStart ).isWater();
 
     if ( !isFirstNode && !isTileAvailableForWalkThrough( currentNodeIdx, fromWater ) ) {
@@ -520,17 +963,16 @@ void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplor
             }
 
             const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, monsterIndex, direction );
-            const uint32_t movementCost = currentNode._cost + movementPenalty;
-
-            WorldNode & monsterNode = _cache[monsterIndex];
+            const uint32_t movementCost = _cache.getCost( currentNodeIdx ) + movementPenalty;
 
-            if ( monsterNode._from == -1 || monsterNode._cost > movementCost ) {
-                monsterNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
+            if ( _cache.getFrom( monsterIndex ) == -1 || _cache.getCost( monsterIndex ) > movementCost ) {
+                _cache.update( monsterIndex, currentNodeIdx, movementCost,
+                               subtractMovePoints( _cache.getRemainingMovePoints( currentNodeIdx ), movementPenalty, maxMovePoints ) );
             }
         }
     }
     else {
-        checkAdjacentNodes( nodesToExplore, currentNodeIdx );
+        checkAdjacentNodes( currentNodeIdx );
     }
 }
 
@@ -642,6 +1084,9 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
 
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        processChangedTiles();
+    }
 }
 
 void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill )
@@ -658,53 +1103,87 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor c
 
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        processChangedTiles();
+    }
+}
+
+void AIWorldPathfinder::swap( AIWorldPathfinder & other ) noexcept
+{
+    swapState( other );
+
+    std::swap( _patrolCenter, other._patrolCenter );
+    std::swap( _patrolDistance, other._patrolDistance );
+    std::swap( _maxMovePointsOnLand, other._maxMovePointsOnLand );
+    std::swap( _maxMovePointsOnWater, other._maxMovePointsOnWater );
+    std::swap( _remainingSpellPoints, other._remainingSpellPoints );
+    std::swap( _maxSpellPoints, other._maxSpellPoints );
+    std::swap( _dimensionDoorSPCost, other._dimensionDoorSPCost );
+    std::swap( _dimensionDoorNumOfUses, other._dimensionDoorNumOfUses );
+    std::swap( _armyStrength, other._armyStrength );
+    std::swap( _isOnPatrol, other._isOnPatrol );
+    std::swap( _isArtifactsBagFull, other._isArtifactsBagFull );
+    std::swap( _isEquippedWithSpellBook, other._isEquippedWithSpellBook );
+    std::swap( _isSummonBoatSpellAvailable, other._isSummonBoatSpellAvailable );
+    std::swap( _isDimensionDoorSpellAvailable, other._isDimensionDoorSpellAvailable );
+    std::swap( _townGateCastleIndex, other._townGateCastleIndex );
+    std::swap( _townPortalCastleIndexes, other._townPortalCastleIndexes );
+    std::swap( _minimalArmyStrengthAdvantage, other._minimalArmyStrengthAdvantage );
+    std::swap( _spellPointsReserveRatio, other._spellPointsReserveRatio );
 }
 
 bool AIWorldPathfinder::isTileAccessibleForAI( const int tileIndex )
 {
-    std::optional<bool> & isAccessible = _cache[tileIndex]._isAccessibleForAI;
-    if ( !isAccessible ) {
-        isAccessible = isTileAccessibleForAIWithArmy( tileIndex, _armyStrength, _minimalArmyStrengthAdvantage );
+    const std::optional<bool> cachedResult = _cache.getAICheckResult( tileIndex, WorldNodeCache::AICheck::IS_ACCESSIBLE );
+    if ( cachedResult ) {
+        return *cachedResult;
     }
 
-    return *isAccessible;
+    const bool isAccessible = isTileAccessibleForAIWithArmy( tileIndex, _armyStrength, _minimalArmyStrengthAdvantage );
+    _cache.setAICheckResult( tileIndex, WorldNodeCache::AICheck::IS_ACCESSIBLE, isAccessible );
+
+    return isAccessible;
 }
 
 bool AIWorldPathfinder::isTileAvailableForWalkThroughForAI( const int tileIndex, const bool fromWater )
 {
-    std::optional<bool> & isAvailableForWalkThrough
-        = fromWater ? _cache[tileIndex]._isAvailableForWalkThroughForAI.fromWater : _cache[tileIndex]._isAvailableForWalkThroughForAI.fromLand;
-    if ( !isAvailableForWalkThrough ) {
-        isAvailableForWalkThrough = isTileAvailableForWalkThroughForAIWithArmy( tileIndex, fromWater, _color, _isArtifactsBagFull, _isEquippedWithSpellBook,
-                                                                                _armyStrength, _minimalArmyStrengthAdvantage );
+    const WorldNodeCache::AICheck check
+        = fromWater ? WorldNodeCache::AICheck::IS_AVAILABLE_FOR_WALK_THROUGH_FROM_WATER : WorldNodeCache::AICheck::IS_AVAILABLE_FOR_WALK_THROUGH_FROM_LAND;
+
+    const std::optional<bool> cachedResult = _cache.getAICheckResult( tileIndex, check );
+    if ( cachedResult ) {
+        return *cachedResult;
     }
 
-    return *isAvailableForWalkThrough;
+    const bool isAvailableForWalkThrough = isTileAvailableForWalkThroughForAIWithArmy( tileIndex, fromWater, _color, _isArtifactsBagFull, _isEquippedWithSpellBook,
+                                                                                       _armyStrength, _minimalArmyStrengthAdvantage );
+    _cache.setAICheckResult( tileIndex, check, isAvailableForWalkThrough );
+
+    return isAvailableForWalkThrough;
 }
 
 void AIWorldPathfinder::processWorldMap()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
-    }
+    _changedTiles.clear();
 
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
+    _cache.clear();
+    _cache.update( _pathStart, -1, 0, _remainingMovePoints );
 
-    std::vector<int> nodesToExplore;
-    nodesToExplore.push_back( _pathStart );
+    _nodesToExplore.reset( _cache.size() );
+    _nodesToExplore.push( _pathStart, 0 );
 
-    const auto processTownPortal = [this, &nodesToExplore]( const Spell & spell, const int32_t castleIndex ) {
+    const auto processTownPortal = [this]( const Spell & spell, const int32_t castleIndex ) {
         assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
-        assert( castleIndex != _pathStart && _cache[castleIndex]._from == -1 );
+        assert( castleIndex != _pathStart && _cache.getFrom( castleIndex ) == -1 );
 
         const uint32_t cost = spell.movePoints();
         const uint32_t remaining = ( _remainingMovePoints < cost ) ? 0 : _remainingMovePoints - cost;
 
-        _cache[castleIndex].update( _pathStart, cost, remaining );
+        _cache.update( castleIndex, _pathStart, cost, remaining );
 
-        nodesToExplore.push_back( castleIndex );
+        _nodesToExplore.push( castleIndex, cost );
     };
 
     if ( _townGateCastleIndex != -1 ) {
@@ -719,9 +1198,41 @@ void AIWorldPathfinder::processWorldMap()
         processTownPortal( Spell::TOWNPORTAL, idx );
     }
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+    exploreNodes();
+}
+
+void AIWorldPathfinder::processChangedTiles()
+{
+    const auto isCastleAffected = [this]( const int32_t castleIdx ) {
+        return std::any_of( _changedTiles.begin(), _changedTiles.end(),
+                            [castleIdx]( const int32_t tileIdx ) { return Maps::GetApproximateDistance( tileIdx, castleIdx ) <= 1; } );
+    };
+
+    // Town Gate and Town Portal destinations are reached directly from the path start tile, so they cannot be restored
+    // in the regular way
+    if ( ( _townGateCastleIndex != -1 && isCastleAffected( _townGateCastleIndex ) )
+         || std::any_of( _townPortalCastleIndexes.begin(), _townPortalCastleIndexes.end(), isCastleAffected ) ) {
+        processWorldMap();
+
+        return;
     }
+
+    WorldPathfinder::processChangedTiles();
+}
+
+void AIWorldPathfinder::appendNonAdjacentSources( const int tileIndex, std::vector<int> & sources ) const
+{
+    const MP2::MapObjectType objectType = world.getTile( tileIndex ).getMainObjectType( false );
+    if ( objectType != MP2::OBJ_STONE_LITHS && objectType != MP2::OBJ_WHIRLPOOL ) {
+        return;
+    }
+
+    MapsIndexes teleports = world.GetTeleportEndPoints( tileIndex );
+    if ( teleports.empty() ) {
+        teleports = world.GetWhirlpoolEndPoints( tileIndex );
+    }
+
+    sources.insert( sources.end(), teleports.begin(), teleports.end() );
 }
 
 bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction ) const
@@ -729,11 +1240,9 @@ bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction )
     return isMovementAllowedForColor( from, direction, _color, false, _isSummonBoatSpellAvailable );
 }
 
-void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
+void AIWorldPathfinder::processCurrentNode( const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
-    WorldNode & currentNode = _cache[currentNodeIdx];
-
     // Always allow movement from the starting point to cover the edge case where we got here before this tile became blocked
     if ( !isFirstNode ) {
         const bool isTileAccessible = [this, currentNodeIdx]() {
@@ -750,15 +1259,15 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
 
         if ( !isTileAccessible ) {
             // If we can't move here, then reset the node
-            currentNode.reset();
+            _cache.resetPath( currentNodeIdx );
 
             return;
         }
 
         // No dead ends allowed
-        assert( currentNode._from != -1 );
+        assert( _cache.getFrom( currentNodeIdx ) != -1 );
 
-        const bool fromWater = world.getTile( currentNode._from ).isWater();
+        const bool fromWater = world.getTile( _cache.getFrom( currentNodeIdx ) ).isWater();
 
         if ( !isTileAvailableForWalkThroughForAI( currentNodeIdx, fromWater ) ) {
             return;
@@ -779,30 +1288,30 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
             }
         }
 
+        const uint32_t currentNodeCost = _cache.getCost( currentNodeIdx );
+
         // Special case: movement via teleport
         for ( const int teleportIdx : teleports ) {
-            if ( teleportIdx == _pathStart ) {
+            if ( teleportIdx == _pathStart || isNodeFinal( teleportIdx, currentNodeCost ) ) {
                 continue;
             }
 
-            WorldNode & teleportNode = _cache[teleportIdx];
-
             // Check if the movement is really faster via teleport
-            if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
-                teleportNode.update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
+            if ( _cache.getFrom( teleportIdx ) == -1 || _cache.getCost( teleportIdx ) > currentNodeCost ) {
+                _cache.update( teleportIdx, currentNodeIdx, currentNodeCost, _cache.getRemainingMovePoints( currentNodeIdx ) );
 
-                nodesToExplore.push_back( teleportIdx );
+                _nodesToExplore.push( teleportIdx, currentNodeCost );
             }
         }
 
         // Check adjacent nodes only if we are either not on the teleport tile, or we got here from another endpoint of this teleport.
         // Do not check them if we came to the tile with a teleport from a neighboring tile (and are going to use it for teleportation).
-        if ( !teleports.empty() && std::find( teleports.begin(), teleports.end(), currentNode._from ) == teleports.end() ) {
+        if ( !teleports.empty() && std::find( teleports.begin(), teleports.end(), _cache.getFrom( currentNodeIdx ) ) == teleports.end() ) {
             return;
         }
     }
 
-    checkAdjacentNodes( nodesToExplore, currentNodeIdx );
+    checkAdjacentNodes( currentNodeIdx );
 }
 
 uint32_t AIWorldPathfinder::getMaxMovePoints( const bool onWater ) const
@@ -826,12 +1335,12 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
             return regularPenalty;
         }
 
-        const WorldNode & node = _cache[from];
+        const int prevFrom = _cache.getFrom( from );
 
         // No dead ends allowed
-        assert( node._from != -1 );
+        assert( prevFrom != -1 );
 
-        const int prevStepDirection = Maps::GetDirection( node._from, from );
+        const int prevStepDirection = Maps::GetDirection( prevFrom, from );
         assert( prevStepDirection != Direction::UNKNOWN && prevStepDirection != Direction::CENTER );
 
         // If we are moving from a tile that we technically cannot stand on, then it means that there was
@@ -847,7 +1356,7 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         //
         // The real path will not reach this step, so this logic will be used to estimate distances more
         // accurately when choosing whether to move through objects or past them.
-        return regularPenalty + WorldPathfinder::getMovementPenalty( node._from, from, prevStepDirection );
+        return regularPenalty + WorldPathfinder::getMovementPenalty( prevFrom, from, prevStepDirection );
     }();
 
     const uint32_t maxMovePoints = getMaxMovePoints( fromTile.isWater() );
@@ -856,10 +1365,8 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
     // If we perform pathfinding for a real AI-controlled hero on the map, we should correctly calculate
     // movement penalties when this hero overcomes water obstacles using boats.
     if ( maxMovePoints > 0 ) {
-        const WorldNode & node = _cache[from];
-
         // No dead ends allowed
-        assert( from == _pathStart || node._from != -1 );
+        assert( from == _pathStart || _cache.getFrom( from ) != -1 );
 
         const Maps::Tile & toTile = world.getTile( to );
 
@@ -871,11 +1378,13 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         if ( isComesOnBoard || isDisembarks ) {
             // If the hero is not able to make this movement this turn, then he will have to spend
             // all the movement points next turn.
-            if ( defaultPenalty > node._remainingMovePoints ) {
+            const uint32_t remainingMovePoints = _cache.getRemainingMovePoints( from );
+
+            if ( defaultPenalty > remainingMovePoints ) {
                 return maxMovePoints;
             }
 
-            return node._remainingMovePoints;
+            return remainingMovePoints;
         }
     }
 
@@ -899,12 +1408,13 @@ std::pair<int32_t, bool> AIWorldPathfinder::getFogDiscoveryTile( const Heroes &
         TileCharacteristics bestTile;
 
         for ( size_t idx = 0; idx < _cache.size(); ++idx ) {
-            const uint32_t nodeCost = _cache[idx]._cost;
+            const int32_t tileIdx = static_cast<int32_t>( idx );
+
+            const uint32_t nodeCost = _cache.getCost( tileIdx );
             if ( nodeCost == 0 ) {
                 continue;
             }
 
-            const int32_t tileIdx = static_cast<int32_t>( idx );
             if ( !MP2::isSafeForFogDiscoveryObject( world.getTile( tileIdx ).getMainObjectType( true ) ) ) {
                 continue;
             }
@@ -955,7 +1465,7 @@ std::pair<int32_t, bool> AIWorldPathfinder::getFogDiscoveryTile( const Heroes &
     // If we are unlucky, then we need to do the heavy lifting and consider the accessible tiles that have at least one neighboring tile that is inaccessible to the hero
     // (since there may be unexplored tiles covered with fog on the other side of such an obstacle).
     {
-        const int32_t bestTileIdx = findBestTile( [this]( const int32_t tileIdx ) { return _cache[tileIdx]._cost == 0; } );
+        const int32_t bestTileIdx = findBestTile( [this]( const int32_t tileIdx ) { return _cache.getCost( tileIdx ) == 0; } );
         if ( bestTileIdx != -1 ) {
             return { bestTileIdx, false };
         }
@@ -990,10 +1500,8 @@ int AIWorldPathfinder::getNearestTileToMove( const Heroes & hero )
             continue;
         }
 
-        const WorldNode & node = _cache[newIndex];
-
         // Tile is directly reachable (in one move) and the hero has enough army to defeat potential guards
-        if ( node._cost > 0 && node._from == start ) {
+        if ( _cache.getCost( newIndex ) > 0 && _cache.getFrom( newIndex ) == start ) {
             return newIndex;
         }
     }
@@ -1165,7 +1673,7 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     std::vector<IndexObject> result;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( _cache.getCost( targetIndex ) == 0 ) {
         return result;
     }
 
@@ -1193,7 +1701,7 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     while ( currentNode != _pathStart ) {
         assert( currentNode != -1 );
 
-        const int from = _cache[currentNode]._from;
+        const int from = _cache.getFrom( currentNode );
 
         assert( from != -1 );
 
@@ -1344,7 +1852,7 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, cons
     std::list<Route::Step> path;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( _cache.getCost( targetIndex ) == 0 ) {
         return path;
     }
 
@@ -1364,18 +1872,18 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex, cons
             lastValidNode = currentNode;
         }
 
-        const WorldNode & node = _cache[currentNode];
+        const int from = _cache.getFrom( currentNode );
 
-        assert( node._from != -1 );
+        assert( from != -1 );
 
-        const uint32_t cost = node._cost - _cache[node._from]._cost;
+        const uint32_t cost = _cache.getCost( currentNode ) - _cache.getCost( from );
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_front( currentNode, from, Maps::GetDirection( from, currentNode ), cost );
 
         // The path should not pass through the same tile more than once
-        assert( uniqPathIndexes.insert( node._from ).second );
+        assert( uniqPathIndexes.insert( from ).second );
 
-        currentNode = node._from;
+        currentNode = from;
     }
 
     // Cut the path to the last valid tile/obstacle
@@ -1393,7 +1901,7 @@ uint32_t AIWorldPathfinder::getDistance( const int start, const int targetIndex,
 
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
 
-    return _cache[targetIndex]._cost;
+    return _cache.getCost( targetIndex );
 }
 
 void AIWorldPathfinder::setMinimalArmyStrengthAdvantage( const double advantage )
@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <optional>
@@ -37,38 +40,229 @@ namespace Route
     class Step;
 }
 
-struct WorldNode final
+// Pathfinder cache of world map nodes. Node properties are stored in separate tightly packed arrays (structure of arrays) rather
+// than in an array of node structures: the search mostly accesses only some of these properties at a time, and the entire cache
+// has to be reset before each full evaluation, which is much cheaper for plain arrays.
+class WorldNodeCache final
 {
-    int _from{ -1 };
-    uint32_t _cost{ 0 };
-    // The number of movement points remaining for the hero after moving to this node
-    uint32_t _remainingMovePoints{ 0 };
+public:
+    // When calculating tile availability for an AI-controlled player, various relatively heavy computations are performed, the
+    // result of which does not depend on the direction in which the tile is entered. The results of these calculations can be
+    // cached. Each check is stored as a pair of bits: whether the result is known and the result itself.
+    enum class AICheck : uint8_t
+    {
+        IS_ACCESSIBLE,
+        IS_AVAILABLE_FOR_WALK_THROUGH_FROM_WATER,
+        IS_AVAILABLE_FOR_WALK_THROUGH_FROM_LAND
+    };
+
+    WorldNodeCache() = default;
+    WorldNodeCache( const WorldNodeCache & ) = delete;
+
+    ~WorldNodeCache() = default;
+
+    WorldNodeCache & operator=( const WorldNodeCache & ) = delete;
+
+    size_t size() const
+    {
+        return _from.size();
+    }
+
+    // Changes the number of nodes, all nodes are reset
+    void resize( const size_t size );
+
+    // Resets all nodes, including the cached results of AI checks
+    void clear();
+
+    // Resets the given node, including the cached results of AI checks
+    void resetNode( const int nodeIdx )
+    {
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
 
-    // When calculating tile availability for an AI-controlled player, various relatively heavy computations are
-    // performed, the result of which does not depend on the direction in which the tile is entered. The results
-    // of these calculations can be cached.
-    std::optional<bool> _isAccessibleForAI;
-    struct
+        _from[nodeIdx] = -1;
+        _cost[nodeIdx] = 0;
+        _remainingMovePoints[nodeIdx] = 0;
+
+        const size_t wordIdx = static_cast<size_t>( nodeIdx ) / bitsPerWord;
+        const uint64_t mask = ~( uint64_t{ 1 } << ( static_cast<size_t>( nodeIdx ) % bitsPerWord ) );
+
+        for ( std::vector<uint64_t> & words : _isAICheckEvaluated ) {
+            words[wordIdx] &= mask;
+        }
+    }
+
+    void swap( WorldNodeCache & other ) noexcept;
+
+    // Returns the index of the node from which this node has been reached, or -1 if this node has not been reached
+    int32_t getFrom( const int nodeIdx ) const
     {
-        std::optional<bool> fromWater;
-        std::optional<bool> fromLand;
-    } _isAvailableForWalkThroughForAI;
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
 
-    WorldNode() = default;
+        return _from[nodeIdx];
+    }
 
-    void update( const int from, const uint32_t cost, const uint32_t remainingMovePoints )
+    uint32_t getCost( const int nodeIdx ) const
     {
-        _from = from;
-        _cost = cost;
-        _remainingMovePoints = remainingMovePoints;
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
+
+        return _cost[nodeIdx];
     }
 
-    void reset()
+    // Returns the number of movement points remaining for the hero after moving to this node
+    uint32_t getRemainingMovePoints( const int nodeIdx ) const
     {
-        _from = -1;
-        _cost = 0;
-        _remainingMovePoints = 0;
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
+
+        return _remainingMovePoints[nodeIdx];
+    }
+
+    void update( const int nodeIdx, const int32_t from, const uint32_t cost, const uint32_t remainingMovePoints )
+    {
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
+
+        _from[nodeIdx] = from;
+        _cost[nodeIdx] = cost;
+        _remainingMovePoints[nodeIdx] = remainingMovePoints;
     }
+
+    // Resets the path information of the given node while keeping the cached results of AI checks
+    void resetPath( const int nodeIdx )
+    {
+        update( nodeIdx, -1, 0, 0 );
+    }
+
+    std::optional<bool> getAICheckResult( const int nodeIdx, const AICheck check ) const
+    {
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
+
+        const size_t wordIdx = static_cast<size_t>( nodeIdx ) / bitsPerWord;
+        const uint64_t mask = uint64_t{ 1 } << ( static_cast<size_t>( nodeIdx ) % bitsPerWord );
+        const size_t checkIdx = static_cast<size_t>( check );
+
+        if ( ( _isAICheckEvaluated[checkIdx][wordIdx] & mask ) == 0 ) {
+            return {};
+        }
+
+        return ( _aiCheckResult[checkIdx][wordIdx] & mask ) != 0;
+    }
+
+    void setAICheckResult( const int nodeIdx, const AICheck check, const bool result )
+    {
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < size() );
+
+        const size_t wordIdx = static_cast<size_t>( nodeIdx ) / bitsPerWord;
+        const uint64_t mask = uint64_t{ 1 } << ( static_cast<size_t>( nodeIdx ) % bitsPerWord );
+        const size_t checkIdx = static_cast<size_t>( check );
+
+        _isAICheckEvaluated[checkIdx][wordIdx] |= mask;
+
+        if ( result ) {
+            _aiCheckResult[checkIdx][wordIdx] |= mask;
+        }
+        else {
+            _aiCheckResult[checkIdx][wordIdx] &= ~mask;
+        }
+    }
+
+private:
+    static constexpr size_t bitsPerWord{ 64 };
+    static constexpr size_t aiCheckCount{ 3 };
+
+    std::vector<int32_t> _from;
+    std::vector<uint32_t> _cost;
+    std::vector<uint32_t> _remainingMovePoints;
+
+    // Bitsets with one bit per node for each type of AI check
+    std::array<std::vector<uint64_t>, aiCheckCount> _isAICheckEvaluated;
+    std::array<std::vector<uint64_t>, aiCheckCount> _aiCheckResult;
+};
+
+// Monotone priority queue of world map nodes keyed by their integer movement cost (Dial's algorithm). Since movement penalties
+// are never negative, the cost of a newly added node can never be less than the cost of the node that is currently being
+// processed, so the queue can be implemented as a circular array of buckets, each of which contains nodes with the same cost.
+// Nodes are retrieved in ascending order of their cost, nodes with the same cost are retrieved in the order in which they were
+// added. Each node is retrieved (expanded) at most once, even if it was added to the queue several times, unless it is added to
+// the queue again after it has been expanded.
+//
+// In the reference mode the queue works as a plain FIFO queue, the way the pathfinder explored nodes before this queue was
+// introduced: nodes are retrieved in the order in which they were added, every time they were added, and no node is ever
+// considered as expanded. This mode is much slower and is intended only to verify the results of the pathfinder.
+class WorldNodeQueue final
+{
+public:
+    WorldNodeQueue() = default;
+    WorldNodeQueue( const WorldNodeQueue & ) = delete;
+
+    ~WorldNodeQueue() = default;
+
+    WorldNodeQueue & operator=( const WorldNodeQueue & ) = delete;
+
+    void reset( const size_t worldSize );
+
+    // Removes all nodes from the queue while keeping the information about which nodes have already been expanded. Nodes added
+    // to the queue after this call should not be cheaper than the given cost.
+    void restart( const uint32_t cost );
+
+    // Adds the node to the queue. If this node has already been expanded, then it will be expanded again.
+    void push( const int nodeIdx, const uint32_t cost );
+
+    // Retrieves the node with the lowest cost that has not yet been expanded and marks it as expanded. Returns false if
+    // there are no such nodes left in the queue.
+    bool pop( int & nodeIdx );
+
+    // Same as above, but only retrieves nodes which cost does not exceed the given maximum cost. If there are no such nodes,
+    // then nodes with the given maximum cost can still be added to the queue after this call.
+    bool pop( int & nodeIdx, const uint32_t maxCost );
+
+    void markAsNotExpanded( const int nodeIdx )
+    {
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < _isExpanded.size() );
+
+        _isExpanded[nodeIdx] = 0;
+    }
+
+    bool isExpanded( const int nodeIdx ) const
+    {
+        assert( nodeIdx >= 0 && static_cast<size_t>( nodeIdx ) < _isExpanded.size() );
+
+        return _isExpanded[nodeIdx] != 0;
+    }
+
+    size_t getExpandedNodesCount() const
+    {
+        return _expandedNodesCount;
+    }
+
+    // The mode takes effect after the next reset of the queue
+    void setReferenceMode( const bool enable )
+    {
+        _isReferenceMode = enable;
+    }
+
+    bool isReferenceMode() const
+    {
+        return _isReferenceMode;
+    }
+
+    void swap( WorldNodeQueue & other ) noexcept;
+
+private:
+    // Increases the number of buckets so that a node with the given cost fits into the queue
+    void grow( const uint32_t cost );
+
+    // Retrieves the next node that has not yet been expanded and which cost does not exceed the given maximum cost
+    bool popNext( int & nodeIdx, const uint32_t maxCost );
+
+    // The number of buckets is always a power of two
+    std::vector<std::vector<int>> _buckets;
+    std::vector<uint8_t> _isExpanded;
+
+    uint32_t _currentCost{ 0 };
+    size_t _currentBucketPos{ 0 };
+    size_t _size{ 0 };
+    size_t _expandedNodesCount{ 0 };
+
+    bool _isReferenceMode{ false };
 };
 
 // Abstract class that provides basic functionality for navigating the World Map
@@ -86,17 +280,64 @@ public:
 
     uint32_t getDistance( int targetIndex ) const;
 
+    // Marks the tile as changed (for example, an object has been added to or removed from this tile, or its passability has
+    // changed). The next re-evaluation of the pathfinder cache will update only those parts of the cache that can be affected
+    // by changes on the marked tiles.
+    void markTileChanged( const int32_t tileIndex );
+
+    // Returns the number of nodes expanded since the last full evaluation of the cache
+    size_t getExpandedNodesCount() const
+    {
+        return _nodesToExplore.getExpandedNodesCount();
+    }
+
+    // Makes the pathfinder explore the world map the way it was done before the nodes were expanded in ascending order of their
+    // cost (see WorldNodeQueue). Used to compare the results and the performance of both approaches.
+    void setReferenceExploration( const bool enable )
+    {
+        _nodesToExplore.setReferenceMode( enable );
+    }
+
 protected:
-    void checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx );
+    // Exchanges the cache and the cached hero properties with another pathfinder
+    void swapState( WorldPathfinder & other ) noexcept;
+
+    void checkAdjacentNodes( const int currentNodeIdx );
 
     virtual void processWorldMap();
 
+    // Expands the queued nodes in ascending order of their cost until there are no more nodes left to explore
+    void exploreNodes();
+
+    // Returns true if the node has already been expanded and reaching it with the given cost does not make sense: either its
+    // current cost is not greater, or it has been rejected by the pathfinding rules
+    bool isNodeFinal( const int nodeIdx, const uint32_t cost ) const
+    {
+        if ( !_nodesToExplore.isExpanded( nodeIdx ) ) {
+            return false;
+        }
+
+        return _cache.getFrom( nodeIdx ) == -1 || _cache.getCost( nodeIdx ) <= cost;
+    }
+
+    // Updates the cache after the changes on the tiles marked as changed: the nodes of the shortest path tree that can be
+    // affected by these changes are reset and then reached again from the remaining nodes. If the changes affect the path
+    // start tile or too many nodes, then the entire world map is processed again.
+    virtual void processChangedTiles();
+
+    // Appends the indexes of the tiles from which the given tile can be reached other than by moving from one of its neighboring
+    // tiles (e.g. using teleports). The default implementation can be overridden by a derived class.
+    virtual void appendNonAdjacentSources( const int /* tileIndex */, std::vector<int> & /* sources */ ) const
+    {
+        // Do nothing.
+    }
+
     // Checks whether moving from the source tile in the specified direction is allowed. The default implementation
     // can be overridden by a derived class.
     virtual bool isMovementAllowed( const int from, const int direction ) const;
 
     // Defines the pathfinding rules and should be implemented by a derived class.
-    virtual void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) = 0;
+    virtual void processCurrentNode( const int currentNodeIdx ) = 0;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water. Should be implemented by a derived class.
@@ -109,9 +350,14 @@ protected:
     // overridden by a derived class.
     virtual uint32_t getMovementPenalty( const int from, const int to, const int direction ) const;
 
-    std::vector<WorldNode> _cache;
+    WorldNodeCache _cache;
     std::vector<int> _mapOffset;
 
+    WorldNodeQueue _nodesToExplore;
+
+    // Tiles that have changed since the last re-evaluation of the pathfinder cache
+    std::vector<int32_t> _changedTiles;
+
     // The hero properties used by the pathfinder are cached here not just for optimization, but also because some
     // of them may change even if the position of the hero does not change, so it should be possible to compare the
     // old values with the new ones to determine whether the pathfinder cache needs to be recalculated.
@@ -141,7 +387,7 @@ public:
 
 private:
     // Follows regular passability rules (for the human player)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points. This class is not intended for planning paths passing both on
     // land and on water at the same time, so the maximum number of movement points corresponding to the type of
@@ -170,6 +416,10 @@ public:
     void reEvaluateIfNeeded( const Heroes & hero );
     void reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill );
 
+    // Exchanges the entire state with another pathfinder. Can be used to take over the cache that was evaluated by another
+    // pathfinder instance (for example, in a separate thread) without copying it.
+    void swap( AIWorldPathfinder & other ) noexcept;
+
     // Finds the most profitable tile for fog discovery. Returns a pair consisting of the tile index (-1 if no suitable tile
     // was found) and a boolean value, which takes the value true if there is fog next to this tile (that is, most likely,
     // through this tile hero can get into some new areas), and false otherwise.
@@ -226,11 +476,17 @@ private:
 
     void processWorldMap() override;
 
+    // Falls back to processing the entire world map if changes affect the destinations of the Town Gate or Town Portal spells
+    void processChangedTiles() override;
+
+    // Takes teleports (Stone Liths and Whirlpools) into account
+    void appendNonAdjacentSources( const int tileIndex, std::vector<int> & sources ) const override;
+
     // Adds special logic for AI-controlled heroes to use Summon Boat spell to overcome water obstacles (if available)
     bool isMovementAllowed( const int from, const int direction ) const override;
 
     // Follows custom passability rules (for the AI)
-    void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
+    void processCurrentNode( const int currentNodeIdx ) override;
 
     // Returns the maximum number of movement points, depending on whether the movement is performed by land or by
     // water
@@ -0,0 +1,277 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "agg.h"
+#include "army.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "color.h"
+#include "ground.h"
+#include "image_palette.h"
+#include "logging.h"
+#include "monster.h"
+#include "players.h"
+#include "rand.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+#include "tools.h"
+#include "world.h"
+
+namespace
+{
+    // Both armies are controlled by AI, but they should belong to different players
+    const PlayerColor attackingColor = PlayerColor::BLUE;
+    const PlayerColor defendingColor = PlayerColor::RED;
+
+    // Index of the tile on the battle-only map where the battle takes place
+    const int32_t battleTileIndex = 1;
+
+    const uint32_t defaultBattleCount = 1000;
+
+    using ArmyDefinition = std::vector<std::pair<Monster, uint32_t>>;
+
+    std::string normalizeMonsterName( std::string name )
+    {
+        std::replace( name.begin(), name.end(), '_', ' ' );
+
+        return StringLower( std::move( name ) );
+    }
+
+    std::optional<Monster> parseMonster( const std::string & str )
+    {
+        if ( !str.empty() && std::all_of( str.begin(), str.end(), []( const char ch ) { return ch >= '0' && ch <= '9'; } ) ) {
+            const long monsterId = std::strtol( str.c_str(), nullptr, 10 );
+            if ( monsterId < Monster::PEASANT || monsterId > Monster::WATER_ELEMENT ) {
+                return {};
+            }
+
+            return Monster( static_cast<int>( monsterId ) );
+        }
+
+        const std::string name = normalizeMonsterName( str );
+
+        for ( int monsterId = Monster::PEASANT; monsterId <= Monster::WATER_ELEMENT; ++monsterId ) {
+            const Monster monster( monsterId );
+
+            if ( normalizeMonsterName( monster.GetName() ) == name ) {
+                return monster;
+            }
+        }
+
+        return {};
+    }
+
+    // The army definition has the following format: monster:count[,monster:count...], where monster is either a monster ID
+    // or a monster name (spaces in the name can be replaced with underscores)
+    std::optional<ArmyDefinition> parseArmy( const std::string & str )
+    {
+        ArmyDefinition result;
+
+        size_t pos = 0;
+
+        while ( pos <= str.size() ) {
+            const size_t troopEnd = std::min( str.find( ',', pos ), str.size() );
+            const std::string troop = str.substr( pos, troopEnd - pos );
+
+            pos = troopEnd + 1;
+
+            const size_t separatorPos = troop.rfind( ':' );
+            if ( separatorPos == std::string::npos ) {
+                std::cerr << "Invalid troop definition: " << troop << std::endl;
+                return {};
+            }
+
+            const std::optional<Monster> monster = parseMonster( troop.substr( 0, separatorPos ) );
+            if ( !monster ) {
+                std::cerr << "Unknown monster: " << troop.substr( 0, separatorPos ) << std::endl;
+                return {};
+            }
+
+            const long count = std::strtol( troop.c_str() + separatorPos + 1, nullptr, 10 );
+            if ( count <= 0 || count > 0xFFFF ) {
+                std::cerr << "Invalid number of monsters: " << troop.substr( separatorPos + 1 ) << std::endl;
+                return {};
+            }
+
+            result.emplace_back( *monster, static_cast<uint32_t>( count ) );
+        }
+
+        if ( result.empty() || result.size() > Army::maximumTroopCount ) {
+            std::cerr << "An army should consist of 1 to " << Army::maximumTroopCount << " troops: " << str << std::endl;
+            return {};
+        }
+
+        return result;
+    }
+
+    void initArmy( Army & army, const ArmyDefinition & definition, const PlayerColor color )
+    {
+        army.SetColor( color );
+
+        for ( const auto & [monster, count] : definition ) {
+            army.JoinTroop( monster, count, true );
+        }
+    }
+
+    struct BattleStatistics
+    {
+        uint32_t battles{ 0 };
+        uint32_t attackerWins{ 0 };
+        uint32_t defenderWins{ 0 };
+        uint64_t totalTurns{ 0 };
+        uint32_t minTurns{ UINT32_MAX };
+        uint32_t maxTurns{ 0 };
+
+        // Checksum of the results of all battles, can be used to detect changes in the battle logic or in the behavior of AI
+        uint32_t checksum{ 0 };
+    };
+
+    void simulateBattle( const ArmyDefinition & attackingArmyDefinition, const ArmyDefinition & defendingArmyDefinition, const uint32_t seed,
+                         BattleStatistics & stats )
+    {
+        Army attackingArmy;
+        Army defendingArmy;
+
+        initArmy( attackingArmy, attackingArmyDefinition, attackingColor );
+        initArmy( defendingArmy, defendingArmyDefinition, defendingColor );
+
+        Rand::PCG32 randomGenerator( seed );
+        Battle::Arena arena( attackingArmy, defendingArmy, battleTileIndex, false, randomGenerator );
+
+        while ( arena.BattleValid() ) {
+            arena.Turns();
+        }
+
+        const Battle::Result & result = arena.GetResult();
+        const uint32_t turns = arena.GetTurnNumber();
+
+        ++stats.battles;
+
+        if ( result.isAttackerWin() ) {
+            ++stats.attackerWins;
+        }
+        else if ( result.isDefenderWin() ) {
+            ++stats.defenderWins;
+        }
+
+        stats.totalTurns += turns;
+        stats.minTurns = std::min( stats.minTurns, turns );
+        stats.maxTurns = std::max( stats.maxTurns, turns );
+
+        const uint32_t battleData[] = { seed, result.attacker, result.defender, turns, arena.getAttackingForce().GetSurrenderCost(),
+                                        arena.getDefendingForce().GetSurrenderCost() };
+
+        stats.checksum ^= fheroes2::calculateCRC32( reinterpret_cast<const uint8_t *>( battleData ), sizeof( battleData ) );
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 3 || argc > 5 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " runs battles between two AI-controlled armies without displaying them and collects statistics." << std::endl
+                  << "Syntax: " << toolName << " attacking_army defending_army [first_seed [last_seed]]" << std::endl
+                  << "Army definition: monster:count[,monster:count...], where monster is a monster ID or name, e.g. Peasant:100,Great_Orc:20" << std::endl
+                  << "Game data files are searched in the same locations as the game does, e.g. in the directory specified by FHEROES2_DATA." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::optional<ArmyDefinition> attackingArmyDefinition = parseArmy( argv[1] );
+    const std::optional<ArmyDefinition> defendingArmyDefinition = parseArmy( argv[2] );
+    if ( !attackingArmyDefinition || !defendingArmyDefinition ) {
+        return EXIT_FAILURE;
+    }
+
+    const uint32_t firstSeed = ( argc > 3 ) ? static_cast<uint32_t>( std::strtoul( argv[3], nullptr, 10 ) ) : 0;
+    const uint32_t lastSeed = ( argc > 4 ) ? static_cast<uint32_t>( std::strtoul( argv[4], nullptr, 10 ) ) : firstSeed + defaultBattleCount - 1;
+    if ( lastSeed < firstSeed ) {
+        std::cerr << "The last seed should not be less than the first seed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Logging::InitLog();
+
+        Settings & conf = Settings::Get();
+        conf.SetProgramPath( argv[0] );
+
+        // Monster animation data is required for the battle logic, but neither the display nor the audio is initialized
+        const AGG::AGGInitializer aggInitializer;
+
+        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ).toVector() );
+
+        world.generateBattleOnlyMap( Maps::Ground::GRASS );
+
+        conf.GetPlayers().Init( attackingColor | defendingColor );
+        world.InitKingdoms();
+
+        for ( const PlayerColor color : { attackingColor, defendingColor } ) {
+            Players::SetPlayerControl( color, CONTROL_AI );
+        }
+
+        BattleStatistics stats;
+
+        const fheroes2::Time timer;
+
+        for ( uint32_t seed = firstSeed;; ++seed ) {
+            simulateBattle( *attackingArmyDefinition, *defendingArmyDefinition, seed, stats );
+
+            if ( seed == lastSeed ) {
+                break;
+            }
+        }
+
+        const double elapsedTime = timer.getS();
+
+        const auto percentage = [&stats]( const uint32_t value ) { return 100.0 * value / stats.battles; };
+
+        std::cout << "Battles: " << stats.battles << std::endl
+                  << "Attacker wins: " << stats.attackerWins << " (" << percentage( stats.attackerWins ) << "%)" << std::endl
+                  << "Defender wins: " << stats.defenderWins << " (" << percentage( stats.defenderWins ) << "%)" << std::endl
+                  << "Turns per battle: average " << static_cast<double>( stats.totalTurns ) / stats.battles << ", min " << stats.minTurns << ", max "
+                  << stats.maxTurns << std::endl
+                  << "Elapsed time: " << elapsedTime << " s" << std::endl;
+
+        if ( elapsedTime > 0 ) {
+            std::cout << "Battles per second: " << stats.battles / elapsedTime << std::endl;
+        }
+
+        std::cout << "Results checksum: " << std::hex << stats.checksum << std::dec << std::endl;
+    }
+    catch ( const std::exception & ex ) {
+        std::cerr << "Exception occurred: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "agg_file.h"
+#include "image.h"
+#include "image_palette.h"
+#include "image_tool.h"
+#include "serialize.h"
+#include "system.h"
+#include "timing.h"
+
+namespace
+{
+    constexpr size_t validPaletteSize = 768;
+
+    const uint32_t passCount = 100;
+
+    // Decodes all sprites of the ICN file, returns false if the file can't be read
+    bool readSprites( const std::string & fileName, std::vector<fheroes2::Sprite> & sprites )
+    {
+        StreamFile inputStream;
+        if ( !inputStream.open( fileName, "rb" ) ) {
+            return false;
+        }
+
+        const uint16_t spritesCount = inputStream.getLE16();
+        const uint32_t totalSize = inputStream.getLE32();
+
+        const size_t beginPos = inputStream.tell();
+
+        std::vector<fheroes2::ICNHeader> headers( spritesCount );
+        for ( fheroes2::ICNHeader & header : headers ) {
+            inputStream >> header;
+        }
+
+        for ( uint16_t spriteIdx = 0; spriteIdx < spritesCount; ++spriteIdx ) {
+            const fheroes2::ICNHeader & header = headers[spriteIdx];
+
+            inputStream.seek( beginPos + header.offsetData );
+
+            const uint32_t dataSize = ( spriteIdx + 1 < spritesCount ? headers[spriteIdx + 1].offsetData - header.offsetData : totalSize - header.offsetData );
+            if ( dataSize == 0 ) {
+                continue;
+            }
+
+            const std::vector<uint8_t> buf = inputStream.getRaw( dataSize );
+            if ( buf.size() != dataSize ) {
+                return false;
+            }
+
+            fheroes2::Sprite sprite = fheroes2::decodeICNSprite( buf.data(), buf.data() + dataSize, header );
+            if ( !sprite.empty() ) {
+                sprites.emplace_back( std::move( sprite ) );
+            }
+        }
+
+        return true;
+    }
+
+    // Performs the operation for every sprite the given number of times and returns the elapsed time in seconds
+    template <typename Operation>
+    double measure( const std::vector<fheroes2::Sprite> & sprites, const Operation & operation )
+    {
+        const fheroes2::Time timer;
+
+        for ( uint32_t pass = 0; pass < passCount; ++pass ) {
+            for ( const fheroes2::Sprite & sprite : sprites ) {
+                operation( sprite );
+            }
+        }
+
+        return timer.getS();
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 3 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the time spent on drawing the sprites from the specified ICN file(s) using the specified palette." << std::endl
+                  << "Syntax: " << toolName << " palette_file.pal input_file.icn ..." << std::endl
+                  << "Every drawing operation is performed " << passCount << " times for each sprite." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const char * paletteFileName = argv[1];
+
+    {
+        StreamFile paletteStream;
+        if ( !paletteStream.open( paletteFileName, "rb" ) ) {
+            std::cerr << "Cannot open file " << paletteFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const std::vector<uint8_t> palette = paletteStream.getRaw( 0 );
+        if ( palette.size() != validPaletteSize ) {
+            std::cerr << "Invalid palette size of " << palette.size() << " instead of " << validPaletteSize << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        fheroes2::setGamePalette( palette );
+    }
+
+    std::vector<std::string> inputFileNames;
+    for ( int i = 2; i < argc; ++i ) {
+        if ( System::isShellLevelGlobbingSupported() ) {
+            inputFileNames.emplace_back( argv[i] );
+        }
+        else {
+            System::globFiles( argv[i], inputFileNames );
+        }
+    }
+
+    std::vector<fheroes2::Sprite> sprites;
+
+    for ( const std::string & inputFileName : inputFileNames ) {
+        if ( !readSprites( inputFileName, sprites ) ) {
+            std::cerr << "Cannot read file " << inputFileName << std::endl;
+        }
+    }
+
+    if ( sprites.empty() ) {
+        std::cerr << "No sprites to draw" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int32_t maxWidth = 0;
+    int32_t maxHeight = 0;
+    uint64_t pixelCount = 0;
+    uint64_t transparentPixelCount = 0;
+
+    for ( const fheroes2::Sprite & sprite : sprites ) {
+        maxWidth = std::max( maxWidth, sprite.width() );
+        maxHeight = std::max( maxHeight, sprite.height() );
+
+        const size_t spriteSize = static_cast<size_t>( sprite.width() ) * static_cast<size_t>( sprite.height() );
+        pixelCount += spriteSize;
+
+        if ( !sprite.singleLayer() ) {
+            transparentPixelCount += static_cast<uint64_t>( std::count( sprite.transform(), sprite.transform() + spriteSize, static_cast<uint8_t>( 1 ) ) );
+        }
+    }
+
+    // The same sprites drawn using pixel spans, like the ones of the Adventure Map objects
+    std::vector<fheroes2::Sprite> spanSprites( sprites );
+    for ( fheroes2::Sprite & sprite : spanSprites ) {
+        sprite.buildSpans();
+    }
+
+    // Sprites are drawn on a single-layer image like the display, which is big enough to avoid clipping of any sprite.
+    fheroes2::Image output( maxWidth, maxHeight );
+    output._disableTransformLayer();
+    output.fill( 0 );
+
+    // Any palette which changes colors will do, this one swaps the halves of the palette.
+    std::vector<uint8_t> palette( 256 );
+    for ( size_t i = 0; i < palette.size(); ++i ) {
+        palette[i] = static_cast<uint8_t>( i ^ 0x80 );
+    }
+
+    const auto printResult = [&sprites, pixelCount]( const char * name, const double time ) {
+        std::cout << name << ": " << time * 1e9 / ( static_cast<double>( pixelCount ) * passCount ) << " ns per pixel, "
+                  << time * 1e6 / ( static_cast<double>( sprites.size() ) * passCount ) << " us per sprite" << std::endl;
+    };
+
+    std::cout << "Sprites: " << sprites.size() << ", average size: " << static_cast<double>( pixelCount ) / sprites.size() << " pixels, transparent pixels: "
+              << 100.0 * static_cast<double>( transparentPixelCount ) / static_cast<double>( pixelCount ) << "%" << std::endl;
+
+    printResult( "Blit", measure( sprites, [&output]( const fheroes2::Sprite & sprite ) { fheroes2::Blit( sprite, output, 0, 0 ); } ) );
+    printResult( "Blit flipped", measure( sprites, [&output]( const fheroes2::Sprite & sprite ) { fheroes2::Blit( sprite, output, 0, 0, true ); } ) );
+    printResult( "Blit with spans", measure( spanSprites, [&output]( const fheroes2::Sprite & sprite ) { fheroes2::Blit( sprite, output, 0, 0 ); } ) );
+    printResult( "Blit flipped with spans", measure( spanSprites, [&output]( const fheroes2::Sprite & sprite ) { fheroes2::Blit( sprite, output, 0, 0, true ); } ) );
+    printResult( "AlphaBlit", measure( sprites, [&output]( const fheroes2::Sprite & sprite ) { fheroes2::AlphaBlit( sprite, output, 0, 0, 128 ); } ) );
+    printResult( "ApplyPalette", measure( sprites, [&output, &palette]( const fheroes2::Sprite & sprite ) {
+                     fheroes2::ApplyPalette( sprite, 0, 0, output, 0, 0, sprite.width(), sprite.height(), palette );
+                 } ) );
+    printResult( "Copy", measure( sprites, [&output]( const fheroes2::Sprite & sprite ) {
+                     fheroes2::Copy( sprite, 0, 0, output, 0, 0, sprite.width(), sprite.height() );
+                 } ) );
+    printResult( "Fill", measure( sprites, [&output]( const fheroes2::Sprite & sprite ) { fheroes2::Fill( output, 0, 0, sprite.width(), sprite.height(), 0 ); } ) );
+
+    return EXIT_SUCCESS;
+}
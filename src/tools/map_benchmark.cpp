@@ -0,0 +1,246 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined( __linux__ )
+#include <fstream>
+#endif
+
+#include "agg.h"
+#include "agg_image.h"
+#include "game_interface.h"
+#include "image.h"
+#include "image_palette.h"
+#include "interface_gamearea.h"
+#include "logging.h"
+#include "maps_fileinfo.h"
+#include "math_base.h"
+#include "players.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+#include "tools.h"
+#include "ui_language.h"
+#include "world.h"
+
+namespace
+{
+    const uint32_t defaultFrameCount = 100;
+
+    // The size of the Adventure Map view, as on a Full HD display without the interface panels
+    const fheroes2::Size frameSize{ 1920, 1080 };
+
+    // Objects and heroes are drawn on the whole map like in the View World, the fog would hide most of them at the start of the game
+    const int drawingFlags = Interface::RedrawLevelType::LEVEL_OBJECTS | Interface::RedrawLevelType::LEVEL_HEROES;
+
+    std::optional<uint32_t> parseNumber( const char * str )
+    {
+        char * end = nullptr;
+        const unsigned long value = std::strtoul( str, &end, 10 );
+        if ( end == str || *end != '\0' || value == 0 || value > UINT32_MAX ) {
+            return {};
+        }
+
+        return static_cast<uint32_t>( value );
+    }
+
+    // Returns the resident set size of the process in megabytes if it is available on the current platform
+    std::optional<double> getResidentMemorySize()
+    {
+#if defined( __linux__ )
+        std::ifstream statusStream( "/proc/self/status" );
+
+        std::string line;
+        while ( std::getline( statusStream, line ) ) {
+            // The value is given in kilobytes
+            if ( line.compare( 0, 6, "VmRSS:" ) == 0 ) {
+                return std::strtod( line.c_str() + 6, nullptr ) / 1024;
+            }
+        }
+#endif
+
+        return {};
+    }
+
+    void printResidentMemorySize( const char * name )
+    {
+        const std::optional<double> memorySize = getResidentMemorySize();
+        if ( memorySize ) {
+            std::cout << "\t" << name << " " << *memorySize << " MB";
+        }
+    }
+
+    // Loads the map in the same way as it is done when a new game is started
+    bool loadMap( const std::string & path )
+    {
+        const std::string extension = StringLower( path.substr( path.size() > 5 ? path.size() - 5 : 0 ) );
+        const bool isResurrectionMap = ( extension == ".fh2m" );
+
+        Maps::FileInfo fileInfo;
+
+        if ( isResurrectionMap ? !fileInfo.readResurrectionMap( path, false, fheroes2::getCurrentLanguage() ) : !fileInfo.readMP2Map( path, false ) ) {
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+
+        conf.setCurrentMapInfo( fileInfo );
+        conf.GetPlayers().SetStartGame();
+
+        const Maps::FileInfo & mapInfo = conf.getCurrentMapInfo();
+        if ( isResurrectionMap ) {
+            return world.loadResurrectionMap( mapInfo.filename );
+        }
+
+        return world.LoadMapMP2( mapInfo.filename, ( mapInfo.version == GameVersion::SUCCESSION_WARS ) );
+    }
+
+    // Draws the Adventure Map view centered on different tiles scattered over the whole map and returns the time of every frame in seconds
+    std::vector<double> renderFrames( const uint32_t frameCount )
+    {
+        Interface::GameArea & gameArea = Interface::AdventureMap::Get().getGameArea();
+        gameArea.SetAreaPosition( 0, 0, frameSize.width, frameSize.height );
+
+        fheroes2::Image frame;
+        frame._disableTransformLayer();
+        frame.resize( frameSize.width, frameSize.height );
+
+        std::vector<double> frameTimes;
+        frameTimes.reserve( frameCount );
+
+        for ( uint32_t frameId = 0; frameId < frameCount; ++frameId ) {
+            gameArea.SetCenter( { static_cast<int32_t>( frameId * 37 % static_cast<uint32_t>( world.w() ) ),
+                                  static_cast<int32_t>( frameId * 61 % static_cast<uint32_t>( world.h() ) ) } );
+
+            const fheroes2::Time timer;
+
+            gameArea.Redraw( frame, drawingFlags );
+
+            frameTimes.push_back( timer.getS() );
+        }
+
+        return frameTimes;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 2 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the time spent on loading the specified maps and on drawing them, as well as the memory used." << std::endl
+                  << "Syntax: " << toolName << " [-f frames] [-n] map_file ..." << std::endl
+                  << "By default " << defaultFrameCount << " frames of " << frameSize.width << "x" << frameSize.height << " pixels are drawn for each map." << std::endl
+                  << "The -n option disables drawing of the Adventure Map sprites using pixel spans." << std::endl
+                  << "The memory usage is reported only on Linux." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int argId = 1;
+    std::optional<uint32_t> frameCount = defaultFrameCount;
+    bool usePixelSpans = true;
+
+    for ( ; argId < argc && frameCount; ++argId ) {
+        const std::string option = argv[argId];
+
+        if ( option == "-f" ) {
+            frameCount = ( argId + 1 < argc ) ? parseNumber( argv[argId + 1] ) : std::nullopt;
+            ++argId;
+        }
+        else if ( option == "-n" ) {
+            usePixelSpans = false;
+        }
+        else {
+            break;
+        }
+    }
+
+    if ( !frameCount || argId == argc ) {
+        std::cerr << "The number of frames should be a positive number followed by at least one map file" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        // Sprites are loaded on the first use, so this setting applies to all of them
+        fheroes2::AGG::setPixelSpanDrawing( usePixelSpans );
+
+        // Sprites are required to draw the map, but neither the display nor the audio is initialized
+        const AGG::AGGInitializer aggInitializer;
+
+        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ).toVector() );
+
+        std::cout << "Pixel spans are " << ( usePixelSpans ? "enabled" : "disabled" ) << std::endl;
+
+        std::cout << "Map\tsize";
+        printResidentMemorySize( "RSS at start" );
+        std::cout << std::endl;
+
+        for ( ; argId < argc; ++argId ) {
+            const std::string mapFile = argv[argId];
+
+            std::cout << System::GetFileName( mapFile ) << "\t";
+
+            const fheroes2::Time loadTimer;
+
+            if ( !loadMap( mapFile ) ) {
+                std::cout << "FAILED to load" << std::endl;
+                continue;
+            }
+
+            const double loadTime = loadTimer.getS();
+
+            std::cout << world.w() << "x" << world.h() << "\tload " << loadTime * 1000 << " ms";
+            printResidentMemorySize( "RSS after load" );
+
+            // The first frame of every view loads the sprites that have not been used yet, so the frames are drawn twice and only the second time is measured.
+            renderFrames( *frameCount );
+
+            const std::vector<double> frameTimes = renderFrames( *frameCount );
+
+            double totalTime = 0;
+            for ( const double time : frameTimes ) {
+                totalTime += time;
+            }
+
+            std::cout << "\tredraw average " << totalTime * 1000 / frameTimes.size() << " ms, max " << *std::max_element( frameTimes.begin(), frameTimes.end() ) * 1000
+                      << " ms";
+            printResidentMemorySize( "RSS after redraw" );
+            std::cout << std::endl;
+        }
+    }
+    catch ( const std::exception & ex ) {
+        std::cerr << "Exception occurred: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
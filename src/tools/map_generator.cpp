@@ -0,0 +1,306 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "logging.h"
+#include "map_format_info.h"
+#include "map_random_generator.h"
+#include "maps.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+
+namespace
+{
+    const uint32_t defaultMapCount = 100;
+
+    struct GeneratorOptions
+    {
+        Maps::Random_Generator::Configuration config;
+        int32_t mapSize{ Maps::MEDIUM };
+        std::string outputDirectory;
+        uint32_t firstSeed{ 0 };
+        uint32_t lastSeed{ 0 };
+    };
+
+    struct GeneratorStatistics
+    {
+        uint32_t maps{ 0 };
+        uint32_t failures{ 0 };
+        double totalTime{ 0 };
+        double maxTime{ 0 };
+        double totalRegionSizeBalance{ 0 };
+        double worstRegionSizeBalance{ 1 };
+    };
+
+    std::optional<int32_t> parseNumber( const std::string & str, const int32_t minValue, const int32_t maxValue )
+    {
+        if ( str.empty() || !std::all_of( str.begin(), str.end(), []( const char ch ) { return ch >= '0' && ch <= '9'; } ) ) {
+            return {};
+        }
+
+        const long value = std::strtol( str.c_str(), nullptr, 10 );
+        if ( value < minValue || value > maxValue ) {
+            return {};
+        }
+
+        return static_cast<int32_t>( value );
+    }
+
+    std::optional<int32_t> parseMapSize( const std::string & str )
+    {
+        for ( const int32_t mapSize : { Maps::SMALL, Maps::MEDIUM, Maps::LARGE, Maps::XLARGE } ) {
+            if ( std::to_string( mapSize ) == str ) {
+                return mapSize;
+            }
+        }
+
+        return {};
+    }
+
+    // Options have the form -option value and are followed by the first and optionally the last seed
+    std::optional<GeneratorOptions> parseOptions( const std::vector<std::string> & arguments )
+    {
+        GeneratorOptions options;
+
+        size_t argId = 0;
+
+        for ( ; argId + 1 < arguments.size() && arguments[argId].size() == 2 && arguments[argId][0] == '-'; argId += 2 ) {
+            const std::string & value = arguments[argId + 1];
+
+            if ( arguments[argId][1] == 'o' ) {
+                options.outputDirectory = value;
+                continue;
+            }
+
+            std::optional<int32_t> number;
+
+            switch ( arguments[argId][1] ) {
+            case 's':
+                number = parseMapSize( value );
+                if ( number ) {
+                    options.mapSize = *number;
+                }
+                break;
+            case 'p':
+                number = parseNumber( value, 2, 6 );
+                if ( number ) {
+                    options.config.playerCount = *number;
+                }
+                break;
+            case 'w':
+                number = parseNumber( value, 0, 99 );
+                if ( number ) {
+                    options.config.waterPercentage = *number;
+                }
+                break;
+            case 'r':
+                number = parseNumber( value, 0, static_cast<int32_t>( Maps::Random_Generator::ResourceDensity::ITEM_COUNT ) - 1 );
+                if ( number ) {
+                    options.config.resourceDensity = static_cast<Maps::Random_Generator::ResourceDensity>( *number );
+                }
+                break;
+            case 'm':
+                number = parseNumber( value, 0, static_cast<int32_t>( Maps::Random_Generator::MonsterStrength::DEADLY ) );
+                if ( number ) {
+                    options.config.monsterStrength = static_cast<Maps::Random_Generator::MonsterStrength>( *number );
+                }
+                break;
+            default:
+                break;
+            }
+
+            if ( !number ) {
+                std::cerr << "Invalid option: " << arguments[argId] << " " << value << std::endl;
+                return {};
+            }
+        }
+
+        const size_t seedArgCount = arguments.size() - argId;
+        if ( seedArgCount < 1 || seedArgCount > 2 ) {
+            std::cerr << "The first seed and optionally the last seed should follow the options" << std::endl;
+            return {};
+        }
+
+        // Seed 0 makes the generator choose a random seed, so it can't be used to reproduce a map.
+        const std::optional<int32_t> firstSeed = parseNumber( arguments[argId], 1, INT32_MAX );
+        if ( !firstSeed ) {
+            std::cerr << "Seeds should be in the range from 1 to " << INT32_MAX << std::endl;
+            return {};
+        }
+
+        std::optional<int32_t> lastSeed = static_cast<int32_t>( std::min<int64_t>( static_cast<int64_t>( *firstSeed ) + defaultMapCount - 1, INT32_MAX ) );
+        if ( seedArgCount > 1 ) {
+            lastSeed = parseNumber( arguments[argId + 1], 1, INT32_MAX );
+        }
+
+        if ( !lastSeed || *lastSeed < *firstSeed ) {
+            std::cerr << "The last seed should be in the range from 1 to " << INT32_MAX << " and should not be less than the first seed" << std::endl;
+            return {};
+        }
+
+        options.firstSeed = static_cast<uint32_t>( *firstSeed );
+        options.lastSeed = static_cast<uint32_t>( *lastSeed );
+
+        const int32_t maxWaterPercentage = Maps::Random_Generator::calculateMaximumWaterPercentage( options.config.playerCount, options.mapSize );
+        if ( options.config.waterPercentage > maxWaterPercentage ) {
+            std::cerr << "The water percentage for " << options.config.playerCount << " players on this map size should not exceed " << maxWaterPercentage << std::endl;
+            return {};
+        }
+
+        return options;
+    }
+
+    // Generates the map for the given seed, saves it if necessary and prints one line of the report
+    void generateMap( const GeneratorOptions & options, const uint32_t seed, GeneratorStatistics & stats )
+    {
+        Maps::Random_Generator::Configuration config = options.config;
+        config.seed = static_cast<int32_t>( seed );
+
+        Maps::Map_Format::MapFormat mapFormat;
+        Maps::Random_Generator::MapStatistics mapStats;
+
+        const fheroes2::Time timer;
+
+        const bool isGenerated = Maps::Random_Generator::generateMap( mapFormat, config, options.mapSize, options.mapSize, &mapStats );
+
+        const double elapsedTime = timer.getS();
+
+        ++stats.maps;
+        stats.totalTime += elapsedTime;
+        stats.maxTime = std::max( stats.maxTime, elapsedTime );
+
+        std::cout << seed << "\t" << elapsedTime * 1000 << " ms\t";
+
+        if ( !isGenerated || mapStats.startingRegionSizes.empty() ) {
+            ++stats.failures;
+
+            std::cout << "FAILED" << std::endl;
+            return;
+        }
+
+        const auto [minSize, maxSize] = std::minmax_element( mapStats.startingRegionSizes.begin(), mapStats.startingRegionSizes.end() );
+        const auto [minConnections, maxConnections] = std::minmax_element( mapStats.startingRegionConnections.begin(), mapStats.startingRegionConnections.end() );
+
+        // The ratio of the smallest starting region to the biggest one, 1 means that all players start with the same amount of space.
+        const double regionSizeBalance = ( *maxSize > 0 ) ? static_cast<double>( *minSize ) / *maxSize : 0.0;
+
+        std::cout << "regions " << mapStats.regionCount << "\tstarting region size " << *minSize << "-" << *maxSize << " (balance " << regionSizeBalance
+                  << ")\tconnections " << *minConnections << "-" << *maxConnections;
+
+        if ( !options.outputDirectory.empty() ) {
+            const std::string path
+                = System::concatPath( options.outputDirectory, "random_" + std::to_string( options.mapSize ) + "_" + std::to_string( seed ) + ".fh2m" );
+
+            if ( !Maps::Map_Format::saveMap( path, mapFormat ) ) {
+                ++stats.failures;
+
+                std::cout << "\tFAILED to save " << path << std::endl;
+                return;
+            }
+        }
+
+        // Only successfully generated (and saved) maps are taken into account, like in the average calculated from the number of such maps.
+        stats.totalRegionSizeBalance += regionSizeBalance;
+        stats.worstRegionSizeBalance = std::min( stats.worstRegionSizeBalance, regionSizeBalance );
+
+        std::cout << std::endl;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 2 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " generates random maps for a range of seeds without displaying them and collects statistics." << std::endl
+                  << "Syntax: " << toolName << " [-s map_size] [-p players] [-w water_percentage] [-r resources] [-m monsters] [-o output_dir] first_seed [last_seed]"
+                  << std::endl
+                  << "map_size: 36, 72 (default), 108 or 144" << std::endl
+                  << "players: 2 (default) to 6" << std::endl
+                  << "resources: 0 - scarce, 1 - normal (default), 2 - abundant" << std::endl
+                  << "monsters: 0 - weak, 1 - normal (default), 2 - strong, 3 - deadly" << std::endl
+                  << "output_dir: the directory to save the generated maps to, maps are not saved if it is not specified" << std::endl
+                  << "Seeds should be greater than 0, by default " << defaultMapCount << " maps are generated starting from the first seed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::optional<GeneratorOptions> options = parseOptions( { argv + 1, argv + argc } );
+    if ( !options ) {
+        return EXIT_FAILURE;
+    }
+
+    if ( !options->outputDirectory.empty() && !System::IsDirectory( options->outputDirectory ) && !System::MakeDirectory( options->outputDirectory ) ) {
+        std::cerr << "Unable to create the output directory " << options->outputDirectory << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        GeneratorStatistics stats;
+
+        const fheroes2::Time timer;
+
+        // The generator builds the map in the global world object, so maps are generated one after another. Run several instances
+        // of the tool with disjoint seed ranges to use more CPU cores.
+        for ( uint32_t seed = options->firstSeed;; ++seed ) {
+            generateMap( *options, seed, stats );
+
+            if ( seed == options->lastSeed ) {
+                break;
+            }
+        }
+
+        const double elapsedTime = timer.getS();
+        const uint32_t generatedMaps = stats.maps - stats.failures;
+
+        std::cout << "Maps: " << stats.maps << std::endl
+                  << "Failures: " << stats.failures << " (" << 100.0 * stats.failures / stats.maps << "%)" << std::endl
+                  << "Generation time per map: average " << stats.totalTime * 1000 / stats.maps << " ms, max " << stats.maxTime * 1000 << " ms" << std::endl;
+
+        if ( generatedMaps > 0 ) {
+            std::cout << "Starting region size balance: average " << stats.totalRegionSizeBalance / generatedMaps << ", worst " << stats.worstRegionSizeBalance
+                      << std::endl;
+        }
+
+        std::cout << "Elapsed time: " << elapsedTime << " s" << std::endl;
+
+        if ( elapsedTime > 0 ) {
+            std::cout << "Maps per second: " << stats.maps / elapsedTime << std::endl;
+        }
+    }
+    catch ( const std::exception & ex ) {
+        std::cerr << "Exception occurred: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
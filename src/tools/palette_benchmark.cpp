@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "image_palette.h"
+#include "system.h"
+#include "timing.h"
+
+namespace
+{
+    const uint32_t defaultFrameCount = 100;
+
+    struct Resolution
+    {
+        int32_t width;
+        int32_t height;
+    };
+
+    constexpr std::array<Resolution, 3> resolutions{ { { 1920, 1080 }, { 2560, 1440 }, { 3840, 2160 } } };
+
+    std::optional<uint32_t> parseNumber( const char * str )
+    {
+        char * end = nullptr;
+        const unsigned long value = std::strtoul( str, &end, 10 );
+        if ( end == str || *end != '\0' || value == 0 || value > UINT32_MAX ) {
+            return {};
+        }
+
+        return static_cast<uint32_t>( value );
+    }
+
+    // Converts the whole frame the given number of times and returns the average time of one frame in milliseconds
+    template <typename Convert>
+    double measure( const uint32_t frameCount, const Convert & convert )
+    {
+        const fheroes2::Time timer;
+
+        for ( uint32_t frame = 0; frame < frameCount; ++frame ) {
+            convert();
+        }
+
+        return timer.getS() * 1000 / frameCount;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc > 2 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the time spent on converting a frame of palette indexes into 32-bit pixels at different resolutions." << std::endl
+                  << "Syntax: " << toolName << " [frames]" << std::endl
+                  << "By default " << defaultFrameCount << " frames are converted at every resolution." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::optional<uint32_t> frameCount = ( argc > 1 ) ? parseNumber( argv[1] ) : defaultFrameCount;
+    if ( !frameCount ) {
+        std::cerr << "The number of frames should be a positive number" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The result does not depend on the colors, only on the fact that every lookup goes to a random place of the table.
+    std::mt19937 seededGen( 0 );
+
+    std::vector<uint32_t> palette( 256 );
+    for ( uint32_t & value : palette ) {
+        value = static_cast<uint32_t>( seededGen() );
+    }
+
+    for ( const Resolution & resolution : resolutions ) {
+        const size_t pixelCount = static_cast<size_t>( resolution.width ) * static_cast<size_t>( resolution.height );
+
+        std::vector<uint8_t> in( pixelCount );
+        for ( uint8_t & value : in ) {
+            value = static_cast<uint8_t>( seededGen() );
+        }
+
+        std::vector<uint32_t> out( pixelCount );
+
+        // The same loop as the one used for the conversion before the dedicated row kernel.
+        const double lookupTime = measure( *frameCount, [&in, &out, &palette]() {
+            const uint8_t * inX = in.data();
+            for ( uint32_t & value : out ) {
+                value = palette[*inX];
+                ++inX;
+            }
+        } );
+
+        const double rowTime = measure( *frameCount, [&in, &out, &palette, &resolution]() {
+            for ( int32_t y = 0; y < resolution.height; ++y ) {
+                const ptrdiff_t offset = static_cast<ptrdiff_t>( y ) * resolution.width;
+                fheroes2::convertPaletteRow( in.data() + offset, out.data() + offset, resolution.width, palette.data() );
+            }
+        } );
+
+        const double areaTime = measure( *frameCount, [&in, &out, &palette, &resolution]() {
+            fheroes2::convertPaletteArea( in.data(), resolution.width, out.data(), resolution.width, resolution.width, resolution.height, palette.data() );
+        } );
+
+        std::cout << resolution.width << "x" << resolution.height << ": per-pixel lookup " << lookupTime << " ms, row kernel " << rowTime << " ms, row bands in parallel "
+                  << areaTime << " ms per frame" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
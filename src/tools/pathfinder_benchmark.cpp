@@ -0,0 +1,360 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "army.h"
+#include "castle.h"
+#include "color.h"
+#include "heroes.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "maps_fileinfo.h"
+#include "players.h"
+#include "route.h"
+#include "settings.h"
+#include "skill.h"
+#include "system.h"
+#include "timing.h"
+#include "tools.h"
+#include "ui_language.h"
+#include "world.h"
+#include "world_pathfinding.h"
+
+namespace
+{
+    const uint32_t defaultRepeatCount = 10;
+
+    // The tile from which the pathfinder cache is evaluated, with the properties of the army located there
+    struct PathStart
+    {
+        int32_t index{ -1 };
+        PlayerColor color{ PlayerColor::NONE };
+        double armyStrength{ 0 };
+    };
+
+    struct PathfinderStatistics
+    {
+        uint64_t searches{ 0 };
+        uint64_t expandedNodes{ 0 };
+        double totalTime{ 0 };
+        double maxTime{ 0 };
+        double resetTime{ 0 };
+    };
+
+    struct VerificationStatistics
+    {
+        uint64_t tiles{ 0 };
+        uint64_t costMismatches{ 0 };
+        uint64_t alternativeRoutes{ 0 };
+        uint64_t invalidRoutes{ 0 };
+    };
+
+    std::optional<uint32_t> parseNumber( const char * str )
+    {
+        char * end = nullptr;
+        const unsigned long value = std::strtoul( str, &end, 10 );
+        if ( end == str || *end != '\0' || value == 0 || value > UINT32_MAX ) {
+            return {};
+        }
+
+        return static_cast<uint32_t>( value );
+    }
+
+    // Loads the map in the same way as it is done when a new game is started
+    bool loadMap( const std::string & path )
+    {
+        const std::string extension = StringLower( path.substr( path.size() > 5 ? path.size() - 5 : 0 ) );
+        const bool isResurrectionMap = ( extension == ".fh2m" );
+
+        Maps::FileInfo fileInfo;
+
+        if ( isResurrectionMap ? !fileInfo.readResurrectionMap( path, false, fheroes2::getCurrentLanguage() ) : !fileInfo.readMP2Map( path, false ) ) {
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+
+        conf.setCurrentMapInfo( fileInfo );
+        conf.GetPlayers().SetStartGame();
+
+        const Maps::FileInfo & mapInfo = conf.getCurrentMapInfo();
+        if ( isResurrectionMap ) {
+            return world.loadResurrectionMap( mapInfo.filename );
+        }
+
+        return world.LoadMapMP2( mapInfo.filename, ( mapInfo.version == GameVersion::SUCCESSION_WARS ) );
+    }
+
+    // The AI evaluates the pathfinder cache from the positions of all heroes and castles on the map to estimate threats
+    std::vector<PathStart> getPathStarts()
+    {
+        std::vector<PathStart> result;
+
+        for ( const PlayerColor color : PlayerColorsVector( Settings::Get().GetPlayers().GetColors() ) ) {
+            const Kingdom & kingdom = world.GetKingdom( color );
+
+            for ( const Heroes * hero : kingdom.GetHeroes() ) {
+                result.push_back( { hero->GetIndex(), color, hero->GetArmy().GetStrength() } );
+            }
+
+            for ( const Castle * castle : kingdom.GetCastles() ) {
+                result.push_back( { castle->GetIndex(), color, castle->GetArmy().GetStrength() } );
+            }
+        }
+
+        return result;
+    }
+
+    void runPathfinder( const std::vector<PathStart> & pathStarts, const uint32_t repeatCount, const bool useReferenceExploration, PathfinderStatistics & stats )
+    {
+        AIWorldPathfinder pathfinder;
+        pathfinder.setReferenceExploration( useReferenceExploration );
+
+        for ( uint32_t repeat = 0; repeat < repeatCount; ++repeat ) {
+            for ( const PathStart & start : pathStarts ) {
+                // The cache is evaluated only if the start conditions change, a reset forces a full evaluation.
+                pathfinder.reset();
+
+                const fheroes2::Time timer;
+
+                pathfinder.reEvaluateIfNeeded( start.index, start.color, start.armyStrength, Skill::Level::EXPERT );
+
+                const double elapsedTime = timer.getS();
+
+                ++stats.searches;
+                stats.expandedNodes += pathfinder.getExpandedNodesCount();
+                stats.totalTime += elapsedTime;
+                stats.maxTime = std::max( stats.maxTime, elapsedTime );
+            }
+        }
+    }
+
+    // Every full evaluation starts with a reset of the entire cache, its cost is measured separately to see which part of the search time it takes
+    void measureCacheReset( const uint64_t resetCount, PathfinderStatistics & stats )
+    {
+        WorldNodeCache cache;
+        cache.resize( world.getSize() );
+
+        const fheroes2::Time timer;
+
+        for ( uint64_t i = 0; i < resetCount; ++i ) {
+            cache.clear();
+        }
+
+        stats.resetTime += timer.getS();
+    }
+
+    // The route should lead from the start tile to the target tile step by step and should cost exactly the same as the cheapest route
+    bool isRouteValid( const std::list<Route::Step> & route, const int32_t startIndex, const int32_t targetIndex, const uint32_t cost )
+    {
+        if ( route.empty() || route.front().GetFrom() != startIndex || route.back().GetIndex() != targetIndex ) {
+            return false;
+        }
+
+        int32_t currentIndex = startIndex;
+        uint32_t routeCost = 0;
+
+        for ( const Route::Step & step : route ) {
+            if ( step.GetFrom() != currentIndex ) {
+                return false;
+            }
+
+            currentIndex = step.GetIndex();
+            routeCost += step.GetPenalty();
+        }
+
+        return routeCost == cost;
+    }
+
+    // Compares the results of the pathfinder with the results of the reference exploration of the world map for every tile of the map.
+    // When several routes to a tile cost exactly the same, the order in which the nodes are expanded determines which one of them is
+    // chosen, so such routes are allowed to differ as long as they are valid and equally cheap.
+    void verifyPathfinder( const std::vector<PathStart> & pathStarts, VerificationStatistics & stats )
+    {
+        AIWorldPathfinder referencePathfinder;
+        referencePathfinder.setReferenceExploration( true );
+
+        AIWorldPathfinder pathfinder;
+
+        const auto isSameStep = []( const Route::Step & first, const Route::Step & second ) {
+            return first.GetIndex() == second.GetIndex() && first.GetFrom() == second.GetFrom() && first.GetPenalty() == second.GetPenalty();
+        };
+
+        for ( const PathStart & start : pathStarts ) {
+            referencePathfinder.reset();
+            referencePathfinder.reEvaluateIfNeeded( start.index, start.color, start.armyStrength, Skill::Level::EXPERT );
+
+            pathfinder.reset();
+            pathfinder.reEvaluateIfNeeded( start.index, start.color, start.armyStrength, Skill::Level::EXPERT );
+
+            for ( int32_t idx = 0; idx < static_cast<int32_t>( world.getSize() ); ++idx ) {
+                ++stats.tiles;
+
+                const uint32_t referenceCost = referencePathfinder.getDistance( idx );
+                if ( pathfinder.getDistance( idx ) != referenceCost ) {
+                    ++stats.costMismatches;
+                    continue;
+                }
+
+                if ( referenceCost == 0 ) {
+                    continue;
+                }
+
+                const std::list<Route::Step> referenceRoute = referencePathfinder.buildPath( idx, false );
+                const std::list<Route::Step> route = pathfinder.buildPath( idx, false );
+
+                if ( std::equal( route.begin(), route.end(), referenceRoute.begin(), referenceRoute.end(), isSameStep ) ) {
+                    continue;
+                }
+
+                if ( isRouteValid( route, start.index, idx, referenceCost ) ) {
+                    ++stats.alternativeRoutes;
+                }
+                else {
+                    ++stats.invalidRoutes;
+                }
+            }
+        }
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 2 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the time spent on evaluating the AI pathfinder cache on the specified maps and verifies the paths." << std::endl
+                  << "Syntax: " << toolName << " [-r repeats] map_file ..." << std::endl
+                  << "The cache is evaluated from the position of every hero and castle on the map, " << defaultRepeatCount << " times by default." << std::endl
+                  << "Every evaluation is also done by the reference exploration of the world map, the costs and the paths to all tiles are compared." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int argId = 1;
+    std::optional<uint32_t> repeatCount = defaultRepeatCount;
+
+    if ( std::string( argv[argId] ) == "-r" ) {
+        repeatCount = ( argc > 3 ) ? parseNumber( argv[argId + 1] ) : std::nullopt;
+        argId += 2;
+    }
+
+    if ( !repeatCount ) {
+        std::cerr << "The number of repeats should be a positive number followed by at least one map file" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        PathfinderStatistics totalStats;
+        PathfinderStatistics totalReferenceStats;
+        VerificationStatistics totalVerificationStats;
+
+        const auto addStatistics = []( PathfinderStatistics & total, const PathfinderStatistics & stats ) {
+            total.searches += stats.searches;
+            total.expandedNodes += stats.expandedNodes;
+            total.totalTime += stats.totalTime;
+            total.maxTime = std::max( total.maxTime, stats.maxTime );
+            total.resetTime += stats.resetTime;
+        };
+
+        for ( ; argId < argc; ++argId ) {
+            const std::string mapFile = argv[argId];
+
+            std::cout << System::GetFileName( mapFile ) << "\t";
+
+            if ( !loadMap( mapFile ) ) {
+                std::cout << "FAILED to load" << std::endl;
+                continue;
+            }
+
+            const std::vector<PathStart> pathStarts = getPathStarts();
+            if ( pathStarts.empty() ) {
+                std::cout << "no heroes or castles" << std::endl;
+                continue;
+            }
+
+            PathfinderStatistics stats;
+            runPathfinder( pathStarts, *repeatCount, false, stats );
+            measureCacheReset( stats.searches, stats );
+
+            PathfinderStatistics referenceStats;
+            runPathfinder( pathStarts, *repeatCount, true, referenceStats );
+
+            VerificationStatistics verificationStats;
+            verifyPathfinder( pathStarts, verificationStats );
+
+            const double expandedNodes = static_cast<double>( stats.expandedNodes ) / stats.searches;
+            const double referenceExpandedNodes = static_cast<double>( referenceStats.expandedNodes ) / referenceStats.searches;
+
+            std::cout << world.w() << "x" << world.h() << "\tstarts " << pathStarts.size() << "\texpanded nodes " << expandedNodes << " ("
+                      << expandedNodes / world.getSize() << " per tile, reference " << referenceExpandedNodes << ")\ttime average "
+                      << stats.totalTime * 1000 / stats.searches << " ms, max " << stats.maxTime * 1000 << " ms (reference "
+                      << referenceStats.totalTime * 1000 / referenceStats.searches << " ms, max " << referenceStats.maxTime * 1000 << " ms)\tcache reset "
+                      << stats.resetTime * 1e6 / stats.searches << " us (" << 100 * stats.resetTime / stats.totalTime << "% of the search time)\tcost mismatches "
+                      << verificationStats.costMismatches << ", invalid paths " << verificationStats.invalidRoutes << ", equally cheap alternative paths "
+                      << verificationStats.alternativeRoutes << std::endl;
+
+            addStatistics( totalStats, stats );
+            addStatistics( totalReferenceStats, referenceStats );
+
+            totalVerificationStats.tiles += verificationStats.tiles;
+            totalVerificationStats.costMismatches += verificationStats.costMismatches;
+            totalVerificationStats.alternativeRoutes += verificationStats.alternativeRoutes;
+            totalVerificationStats.invalidRoutes += verificationStats.invalidRoutes;
+        }
+
+        if ( totalStats.searches > 0 ) {
+            std::cout << "Searches: " << totalStats.searches << std::endl
+                      << "Expanded nodes per search: " << static_cast<double>( totalStats.expandedNodes ) / totalStats.searches << " (reference "
+                      << static_cast<double>( totalReferenceStats.expandedNodes ) / totalReferenceStats.searches << ")" << std::endl
+                      << "Time per search: average " << totalStats.totalTime * 1000 / totalStats.searches << " ms, max " << totalStats.maxTime * 1000
+                      << " ms (reference average " << totalReferenceStats.totalTime * 1000 / totalReferenceStats.searches << " ms, max "
+                      << totalReferenceStats.maxTime * 1000 << " ms)" << std::endl
+                      << "Cache reset time per search: " << totalStats.resetTime * 1e6 / totalStats.searches << " us" << std::endl
+                      << "Verified tiles: " << totalVerificationStats.tiles << ", cost mismatches: " << totalVerificationStats.costMismatches
+                      << ", invalid paths: " << totalVerificationStats.invalidRoutes << ", equally cheap alternative paths: " << totalVerificationStats.alternativeRoutes
+                      << std::endl;
+        }
+
+        if ( totalVerificationStats.costMismatches > 0 || totalVerificationStats.invalidRoutes > 0 ) {
+            std::cerr << "The results of the pathfinder differ from the results of the reference exploration" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    catch ( const std::exception & ex ) {
+        std::cerr << "Exception occurred: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "logging.h"
+#include "system.h"
+#include "timing.h"
+#include "translations.h"
+
+namespace
+{
+    const uint32_t defaultFrameCount = 100000;
+    const uint32_t defaultCallsPerFrame = 200;
+
+    // Messages which are translated on every frame while the mouse cursor moves over the battlefield and the control panel.
+    constexpr std::array<const char *, 24> messages{ "Turn %{turn}",
+                                                     "View %{monster} info",
+                                                     "Skip this unit",
+                                                     "Customize system options",
+                                                     "Show logs",
+                                                     "Hide logs",
+                                                     "Attack %{monster}",
+                                                     "Shoot %{monster}",
+                                                     "Move %{monster} here",
+                                                     "Fly %{monster} here",
+                                                     "Cast %{spell}",
+                                                     "Select spell target",
+                                                     "Automatic combat modes",
+                                                     "View Hero's options",
+                                                     "View opposing Hero",
+                                                     "Teleport here",
+                                                     "Adventure Options",
+                                                     "End Turn",
+                                                     "Next Hero",
+                                                     "System Options",
+                                                     "Cancel",
+                                                     "Okay",
+                                                     "Exit",
+                                                     "This message has no translation" };
+
+    // The same hashes as the ones calculated by the _h() macro at compile time.
+    constexpr std::array<uint32_t, messages.size()> messageHashes = []() {
+        std::array<uint32_t, messages.size()> hashes{};
+
+        for ( size_t i = 0; i < messages.size(); ++i ) {
+            hashes[i] = Translation::getMessageHash( messages[i] );
+        }
+
+        return hashes;
+    }();
+
+    std::optional<uint32_t> parseNumber( const char * str )
+    {
+        char * end = nullptr;
+        const unsigned long value = std::strtoul( str, &end, 10 );
+        if ( end == str || *end != '\0' || value == 0 || value > UINT32_MAX ) {
+            return {};
+        }
+
+        return static_cast<uint32_t>( value );
+    }
+
+    // Translates the given number of messages per frame for the given number of frames and returns the average time of one call in nanoseconds
+    template <typename Translate>
+    double measure( const uint32_t frameCount, const uint32_t callsPerFrame, const Translate & translate )
+    {
+        // The result is used so that the compiler does not throw the calls away.
+        size_t checksum = 0;
+
+        const fheroes2::Time timer;
+
+        for ( uint32_t frame = 0; frame < frameCount; ++frame ) {
+            for ( uint32_t call = 0; call < callsPerFrame; ++call ) {
+                checksum += std::strlen( translate( call % messages.size() ) );
+            }
+        }
+
+        const double elapsedTime = timer.getS();
+
+        if ( checksum == 0 ) {
+            std::cerr << "All translations are empty" << std::endl;
+        }
+
+        return elapsedTime * 1e9 / ( static_cast<double>( frameCount ) * callsPerFrame );
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 2 || argc > 4 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the time spent on translating messages in different ways." << std::endl
+                  << "Syntax: " << toolName << " translation_file.mo [calls_per_frame] [frames]" << std::endl
+                  << "The name of the translation file should be the name of the language, for example de.mo." << std::endl
+                  << "By default " << defaultCallsPerFrame << " messages per frame are translated during " << defaultFrameCount << " frames." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string translationFile = argv[1];
+
+    const std::optional<uint32_t> callsPerFrame = ( argc > 2 ) ? parseNumber( argv[2] ) : defaultCallsPerFrame;
+    const std::optional<uint32_t> frameCount = ( argc > 3 ) ? parseNumber( argv[3] ) : defaultFrameCount;
+
+    if ( !callsPerFrame || !frameCount ) {
+        std::cerr << "The number of calls per frame and the number of frames should be positive numbers" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Logging::InitLog();
+
+    std::string language = System::GetFileName( translationFile );
+    language = language.substr( 0, language.find( '.' ) );
+
+    if ( language.empty() || !Translation::setLanguage( language, translationFile ) ) {
+        std::cerr << "Unable to load the translation file " << translationFile << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Copies of the messages are not string literals, so their translations are looked up by hash on every call.
+    const std::vector<std::string> messageCopies( messages.begin(), messages.end() );
+
+    const double hashingTime = measure( *frameCount, *callsPerFrame, [&messageCopies]( const size_t id ) { return _( messageCopies[id] ); } );
+    const double memoizedTime = measure( *frameCount, *callsPerFrame, []( const size_t id ) { return _( messages[id] ); } );
+    const double precalculatedHashTime
+        = measure( *frameCount, *callsPerFrame, []( const size_t id ) { return Translation::gettext( messages[id], messageHashes[id] ); } );
+
+    const auto printResult = [hashingTime, callsPerFrame]( const char * name, const double time ) {
+        std::cout << name << ": " << time << " ns per call, " << time * *callsPerFrame / 1000 << " us per frame";
+
+        if ( time < hashingTime ) {
+            std::cout << ", saves " << ( hashingTime - time ) * *callsPerFrame / 1000 << " us per frame";
+        }
+
+        std::cout << std::endl;
+    };
+
+    std::cout << "Calls per frame: " << *callsPerFrame << ", frames: " << *frameCount << std::endl;
+
+    printResult( "Hashing on every call", hashingTime );
+    printResult( "Memoized by address, _()", memoizedTime );
+    printResult( "Hashed at compile time, _h()", precalculatedHashTime );
+
+    return EXIT_SUCCESS;
+}